@@ -1440,11 +1440,36 @@ sr_time_sub_ms(const struct timespec *ts1, const struct timespec *ts2)
     return (result.tv_sec * 1000) + (result.tv_nsec / 1000000);
 }
 
+/**
+ * @brief Advise the kernel to back a SHM mapping with huge pages once the used size is large enough.
+ *
+ * @param[in] shm SHM to use.
+ * @param[in] prev_size Previous used size of the SHM with the same mapping, 0 for a new mapping.
+ */
+static void
+sr_shm_huge_pages_advise(sr_shm_t *shm, size_t prev_size)
+{
+#ifdef SR_SHM_HUGE_PAGES
+    if (!shm->huge_pages || (shm->size < SR_SHM_HUGE_PAGE_MIN_SIZE) || (prev_size >= SR_SHM_HUGE_PAGE_MIN_SIZE)) {
+        /* not requested, too small, or already advised */
+        return;
+    }
+
+    /* best effort, fails if transparent huge pages are not enabled for shared memory */
+    if (madvise(shm->addr, shm->map_size, MADV_HUGEPAGE) == -1) {
+        SR_LOG_DBG("Huge pages for shared memory not available (%s).", strerror(errno));
+    }
+#else
+    (void)shm;
+    (void)prev_size;
+#endif
+}
+
 sr_error_info_t *
 sr_shm_remap(sr_shm_t *shm, size_t new_shm_size)
 {
     sr_error_info_t *err_info = NULL;
-    size_t shm_file_size = 0;
+    size_t shm_file_size = 0, prev_size;
 
     /* read the new shm size if not set */
     if (!new_shm_size && (err_info = sr_file_get_size(shm->fd, &shm_file_size))) {
@@ -1456,27 +1481,53 @@ sr_shm_remap(sr_shm_t *shm, size_t new_shm_size)
         return NULL;
     }
 
+    if (shm->addr && ((new_shm_size ? new_shm_size : shm_file_size) <= shm->map_size)) {
+        /* the mapping covers the new size, only truncate if needed */
+        if (new_shm_size && (ftruncate(shm->fd, new_shm_size) == -1)) {
+            sr_errinfo_new(&err_info, SR_ERR_SYS, "Failed to truncate shared memory (%s).", strerror(errno));
+            return err_info;
+        }
+
+        prev_size = shm->size;
+        shm->size = new_shm_size ? new_shm_size : shm_file_size;
+
+        /* the used part of the mapping may have grown large enough */
+        sr_shm_huge_pages_advise(shm, prev_size);
+        return NULL;
+    }
+
     if (shm->addr) {
-        munmap(shm->addr, shm->size);
+        munmap(shm->addr, shm->map_size);
     }
 
     /* truncate if needed */
     if (new_shm_size && (ftruncate(shm->fd, new_shm_size) == -1)) {
         shm->addr = NULL;
+        shm->map_size = 0;
         sr_errinfo_new(&err_info, SR_ERR_SYS, "Failed to truncate shared memory (%s).", strerror(errno));
         return err_info;
     }
 
     shm->size = new_shm_size ? new_shm_size : shm_file_size;
+    shm->map_size = (shm->size > shm->reserve_size) ? shm->size : shm->reserve_size;
 
-    /* map */
-    shm->addr = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    /* map, pages beyond the end of the file become accessible once it grows */
+    shm->addr = mmap(NULL, shm->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    if ((shm->addr == MAP_FAILED) && (shm->map_size > shm->size)) {
+        /* the address space could not be reserved, map only the file */
+        shm->map_size = shm->size;
+        shm->addr = mmap(NULL, shm->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    }
     if (shm->addr == MAP_FAILED) {
         shm->addr = NULL;
+        shm->map_size = 0;
         sr_errinfo_new(&err_info, SR_ERR_NO_MEMORY, "Failed to map shared memory (%s).", strerror(errno));
         return err_info;
     }
 
+    /* whole new mapping */
+    sr_shm_huge_pages_advise(shm, 0);
+
     return NULL;
 }
 
@@ -1484,7 +1535,7 @@ void
 sr_shm_clear(sr_shm_t *shm)
 {
     if (shm->addr) {
-        munmap(shm->addr, shm->size);
+        munmap(shm->addr, shm->map_size);
         shm->addr = NULL;
     }
     if (shm->fd > -1) {
@@ -1492,6 +1543,7 @@ sr_shm_clear(sr_shm_t *shm)
         shm->fd = -1;
     }
     shm->size = 0;
+    shm->map_size = 0;
 }
 
 sr_ext_hole_t *
@@ -2187,6 +2239,14 @@ sr_rwlock_init(sr_rwlock_t *rwlock, int shared)
         pthread_mutex_destroy(&rwlock->mutex);
         return err_info;
     }
+    if ((err_info = sr_cond_init(&rwlock->wr_cond, shared, shared))) {
+        sr_cond_destroy(&rwlock->cond);
+        pthread_mutex_destroy(&rwlock->mutex);
+        return err_info;
+    }
+    rwlock->rd_waiters = 0;
+    rwlock->wr_waiters = 0;
+    rwlock->wr_all_waiters = 0;
 
     memset(rwlock->readers, 0, sizeof rwlock->readers);
     rwlock->upgr = 0;
@@ -2200,6 +2260,7 @@ sr_rwlock_destroy(sr_rwlock_t *rwlock)
 {
     pthread_mutex_destroy(&rwlock->mutex);
     sr_cond_destroy(&rwlock->cond);
+    sr_cond_destroy(&rwlock->wr_cond);
 }
 
 /**
@@ -2378,6 +2439,57 @@ sr_rwlock_recover(sr_rwlock_t *rwlock, const char *func, sr_lock_recover_cb cb,
     }
 }
 
+int
+sr_rwlock_cond_wait(sr_rwlock_t *rwlock, sr_rwlock_wait_t wait_type, struct timespec *timeout_abs)
+{
+    int ret = 0;
+
+    switch (wait_type) {
+    case SR_RWLOCK_WAIT_READ:
+        ++rwlock->rd_waiters;
+        ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+        --rwlock->rd_waiters;
+        break;
+    case SR_RWLOCK_WAIT_WRITE:
+        ++rwlock->wr_waiters;
+        ret = sr_cond_clockwait(&rwlock->wr_cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+        --rwlock->wr_waiters;
+        break;
+    case SR_RWLOCK_WAIT_WRITE_ALL:
+        ++rwlock->wr_all_waiters;
+        ret = sr_cond_clockwait(&rwlock->wr_cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+        --rwlock->wr_all_waiters;
+        break;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Wake waiters of a sysrepo RW lock that may be able to continue after its state has changed.
+ * Mutex must be held!
+ *
+ * Counters of waiters that crashed while waiting are never decreased, which only causes redundant wakeups.
+ *
+ * @param[in] rwlock RW lock to wake the waiters of.
+ */
+static void
+sr_rwlock_wake(sr_rwlock_t *rwlock)
+{
+    if (rwlock->rd_waiters && !rwlock->writer) {
+        /* readers can continue together */
+        sr_cond_broadcast(&rwlock->cond);
+    }
+
+    if (rwlock->wr_all_waiters) {
+        /* waiting for a specific lock state, wake them all to let them check */
+        sr_cond_broadcast(&rwlock->wr_cond);
+    } else if (rwlock->wr_waiters && !rwlock->readers[0] && !rwlock->writer) {
+        /* only one writer can get the lock */
+        sr_cond_signal(&rwlock->wr_cond);
+    }
+}
+
 sr_error_info_t *
 sr_sub_rwlock(sr_rwlock_t *rwlock, struct timespec *timeout_abs, sr_lock_mode_t mode, sr_cid_t cid, const char *func,
         sr_lock_recover_cb cb, void *cb_data, int has_mutex)
@@ -2415,7 +2527,7 @@ sr_sub_rwlock(sr_rwlock_t *rwlock, struct timespec *timeout_abs, sr_lock_mode_t
         ret = 0;
         while (!ret && (rwlock->readers[0] || rwlock->writer)) {
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_WRITE, timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             /* recover the lock again, the owner may have died while processing */
@@ -2453,7 +2565,7 @@ sr_sub_rwlock(sr_rwlock_t *rwlock, struct timespec *timeout_abs, sr_lock_mode_t
             }
 
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_WRITE_ALL, timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             /* recover the lock again, the owner may have died while processing */
@@ -2491,7 +2603,7 @@ sr_sub_rwlock(sr_rwlock_t *rwlock, struct timespec *timeout_abs, sr_lock_mode_t
         ret = 0;
         while (!ret && (rwlock->readers[SR_RWLOCK_READ_LIMIT - 1] || rwlock->upgr || rwlock->writer)) {
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_READ, timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             /* recover the lock again, the owner may have died while processing */
@@ -2528,7 +2640,7 @@ sr_sub_rwlock(sr_rwlock_t *rwlock, struct timespec *timeout_abs, sr_lock_mode_t
         ret = 0;
         while (!ret && (rwlock->readers[SR_RWLOCK_READ_LIMIT - 1] || rwlock->writer)) {
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_READ, timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             /* recover the lock again, the owner may have died while processing */
@@ -2645,7 +2757,7 @@ sr_rwrelock(sr_rwlock_t *rwlock, uint32_t timeout_ms, sr_lock_mode_t mode, sr_ci
         ret = 0;
         while (!ret && (rwlock->readers[1] || (rwlock->read_count[0] > 1) || rwlock->writer)) {
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, &timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_WRITE_ALL, &timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             sr_rwlock_recover(rwlock, func, cb, cb_data);
@@ -2705,7 +2817,7 @@ sr_rwrelock(sr_rwlock_t *rwlock, uint32_t timeout_ms, sr_lock_mode_t mode, sr_ci
             }
 
             /* COND WAIT */
-            ret = sr_cond_clockwait(&rwlock->cond, &rwlock->mutex, COMPAT_CLOCK_ID, &timeout_abs);
+            ret = sr_rwlock_cond_wait(rwlock, SR_RWLOCK_WAIT_WRITE_ALL, &timeout_abs);
         }
         if (ret == ETIMEDOUT) {
             sr_rwlock_recover(rwlock, func, cb, cb_data);
@@ -2758,8 +2870,8 @@ sr_rwrelock(sr_rwlock_t *rwlock, uint32_t timeout_ms, sr_lock_mode_t mode, sr_ci
         assert(rwlock->upgr == cid);
         rwlock->upgr = 0;
 
-        /* broadcast on condition so waiters can grab read-upgr lock */
-        sr_cond_broadcast(&rwlock->cond);
+        /* wake waiters so they can grab read-upgr lock */
+        sr_rwlock_wake(rwlock);
         goto cleanup_unlock;
     }
 
@@ -2851,8 +2963,8 @@ sr_rwunlock(sr_rwlock_t *rwlock, uint32_t timeout_ms, sr_lock_mode_t mode, sr_ci
      * writer waiting, or upgradeable read-unlock (there may be another upgr-read-lock waiting) */
     if (!rwlock->readers[0] || (!rwlock->readers[1] && (rwlock->read_count[0] == 1) && rwlock->upgr) ||
             rwlock->writer || (mode == SR_LOCK_READ_UPGR)) {
-        /* broadcast on condition */
-        sr_cond_broadcast(&rwlock->cond);
+        /* wake the waiters that may continue */
+        sr_rwlock_wake(rwlock);
     }
 
     /* MUTEX UNLOCK */
@@ -2886,10 +2998,40 @@ sr_conn_ext_data_update(sr_conn_ctx_t *conn)
     const struct lys_module *ly_mod;
     struct sr_mod_info_s mi;
     struct lyd_node *yl_data = NULL, *new_ext_data = NULL;
+    sr_mod_t *shm_mod;
+    uint32_t content_id, sm_ver;
+    int valid;
 
     /* init mod info for cleanup */
     SR_MODINFO_INIT(mi, conn, SR_DS_OPERATIONAL, SR_DS_RUNNING);
 
+    /* learn the current versions before getting the data so that a concurrent change is never missed */
+    content_id = SR_CONN_MAIN_SHM(conn)->content_id;
+    sm_ver = ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(conn)->sm_data_ver);
+
+    /* LY EXT DATA READ LOCK */
+    if ((err_info = sr_rwlock(&conn->ly_ext_data_lock, SR_CONN_EXT_DATA_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
+            __func__, NULL, NULL))) {
+        goto cleanup;
+    }
+
+    valid = conn->ly_ext_data_valid && (conn->ly_ext_data_content_id == content_id) &&
+            (conn->ly_ext_data_sm_ver == sm_ver);
+
+    /* LY EXT DATA UNLOCK */
+    sr_rwunlock(&conn->ly_ext_data_lock, SR_CONN_EXT_DATA_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
+
+    if (valid) {
+        /* cached data are up-to-date */
+        goto cleanup;
+    }
+
+    /* the data can be cached only if there is no operational get subscription providing them, its data may change
+     * without any notice */
+    shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(conn), "ietf-yang-schema-mount");
+    assert(shm_mod);
+    valid = !shm_mod->oper_get_sub_count;
+
     /* manually get ietf-yang-schema-mount operational data but avoid recursive call of this function */
     ly_mod = ly_ctx_get_module_implemented(conn->ly_ctx, "ietf-yang-schema-mount");
     assert(ly_mod);
@@ -2930,6 +3072,9 @@ sr_conn_ext_data_update(sr_conn_ctx_t *conn)
     lyd_free_siblings(conn->ly_ext_data);
     conn->ly_ext_data = new_ext_data;
     new_ext_data = NULL;
+    conn->ly_ext_data_content_id = content_id;
+    conn->ly_ext_data_sm_ver = sm_ver;
+    conn->ly_ext_data_valid = valid;
 
     /* LY EXT DATA UNLOCK */
     sr_rwunlock(&conn->ly_ext_data_lock, SR_CONN_EXT_DATA_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
@@ -2944,6 +3089,14 @@ cleanup:
     return err_info;
 }
 
+void
+sr_conn_ext_data_changed(sr_conn_ctx_t *conn, const char *mod_name)
+{
+    if (!strcmp(mod_name, "ietf-yang-schema-mount")) {
+        ATOMIC_INC_RELAXED(SR_CONN_MAIN_SHM(conn)->sm_data_ver);
+    }
+}
+
 sr_error_info_t *
 sr_conn_oper_cache_add(sr_conn_ctx_t *conn, uint32_t sub_id, const char *module_name, const char *path)
 {
@@ -3037,6 +3190,445 @@ sr_conn_oper_cache_del(sr_conn_ctx_t *conn, uint32_t sub_id)
     sr_rwunlock(&conn->oper_cache_lock, SR_CONN_OPER_CACHE_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
 }
 
+/**
+ * @brief Load the current data of a change mirror.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] module_name Mirrored module name.
+ * @param[in] ds Mirrored datastore.
+ * @param[in] mod_lock Module lock to use, ::SR_LOCK_NONE if the module is already locked.
+ * @param[out] data Loaded module data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_conn_change_mirror_load(sr_conn_ctx_t *conn, const char *module_name, sr_datastore_t ds, sr_lock_mode_t mod_lock,
+        struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lys_module *ly_mod;
+    struct sr_mod_info_s mod_info;
+
+    SR_MODINFO_INIT(mod_info, conn, ds, ds);
+
+    ly_mod = ly_ctx_get_module_implemented(conn->ly_ctx, module_name);
+    SR_CHECK_INT_GOTO(!ly_mod, err_info, cleanup);
+
+    /* get the module data */
+    if ((err_info = sr_modinfo_add(ly_mod, NULL, 0, 0, &mod_info))) {
+        goto cleanup;
+    }
+    if ((err_info = sr_modinfo_consolidate(&mod_info, mod_lock, SR_MI_PERM_NO, NULL, 0, 0, 0))) {
+        goto cleanup;
+    }
+
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info);
+
+    /* keep only the data of this module */
+    *data = sr_module_data_unlink(&mod_info.data, ly_mod, 0);
+
+cleanup:
+    sr_modinfo_erase(&mod_info);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_conn_change_mirror_add(sr_conn_ctx_t *conn, uint32_t sub_id, const struct lys_module *ly_mod, const char *xpath,
+        sr_datastore_t ds, int mod_locked)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_change_mirror_s *mirror;
+    struct lyd_node *data = NULL;
+    void *mem;
+
+    /* load the data first */
+    if ((err_info = sr_conn_change_mirror_load(conn, ly_mod->name, ds, mod_locked ? SR_LOCK_NONE : SR_LOCK_READ,
+            &data))) {
+        return err_info;
+    }
+
+    /* CONN CHANGE MIRROR WRITE LOCK */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        lyd_free_siblings(data);
+        return err_info;
+    }
+
+    /* add new mirror entry */
+    mem = realloc(conn->change_mirrors, (conn->change_mirror_count + 1) * sizeof *conn->change_mirrors);
+    SR_CHECK_MEM_GOTO(!mem, err_info, cleanup);
+    conn->change_mirrors = mem;
+    mirror = &conn->change_mirrors[conn->change_mirror_count];
+    memset(mirror, 0, sizeof *mirror);
+
+    /* fill */
+    mirror->sub_id = sub_id;
+    mirror->module_name = strdup(ly_mod->name);
+    SR_CHECK_MEM_GOTO(!mirror->module_name, err_info, cleanup);
+    if (xpath) {
+        mirror->xpath = strdup(xpath);
+        if (!mirror->xpath) {
+            free(mirror->module_name);
+            SR_ERRINFO_MEM(&err_info);
+            goto cleanup;
+        }
+    }
+    mirror->ds = ds;
+    mirror->data = data;
+    data = NULL;
+
+    ++conn->change_mirror_count;
+
+cleanup:
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+
+    lyd_free_siblings(data);
+    return err_info;
+}
+
+void
+sr_conn_change_mirror_del(sr_conn_ctx_t *conn, uint32_t sub_id)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+    struct sr_change_mirror_s *mirror;
+
+    /* CONN CHANGE MIRROR WRITE LOCK */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        /* should never happen */
+        sr_errinfo_free(&err_info);
+    }
+
+    /* find the mirror entry */
+    for (i = 0; i < conn->change_mirror_count; ++i) {
+        if (conn->change_mirrors[i].sub_id == sub_id) {
+            break;
+        }
+    }
+    if (i == conn->change_mirror_count) {
+        /* not added */
+        goto cleanup;
+    }
+    mirror = &conn->change_mirrors[i];
+
+    /* free members */
+    free(mirror->module_name);
+    free(mirror->xpath);
+    lyd_free_siblings(mirror->data);
+
+    /* replace mirror entry with the last */
+    if (i < conn->change_mirror_count - 1) {
+        memcpy(mirror, &conn->change_mirrors[conn->change_mirror_count - 1], sizeof *mirror);
+    }
+    --conn->change_mirror_count;
+
+    if (!conn->change_mirror_count) {
+        /* no other mirror entries */
+        free(conn->change_mirrors);
+        conn->change_mirrors = NULL;
+    }
+
+cleanup:
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+}
+
+sr_error_info_t *
+sr_conn_change_mirror_update(sr_conn_ctx_t *conn, uint32_t sub_id, const struct lyd_node *diff)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lys_module *ly_mod;
+    struct sr_change_mirror_s *mirror = NULL;
+    uint32_t i;
+
+    /* CONN CHANGE MIRROR WRITE LOCK, the data of the mirror are modified */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    for (i = 0; i < conn->change_mirror_count; ++i) {
+        if (conn->change_mirrors[i].sub_id == sub_id) {
+            mirror = &conn->change_mirrors[i];
+            break;
+        }
+    }
+    if (!mirror || !mirror->data) {
+        /* no mirror or not loaded, nothing to update */
+        goto cleanup;
+    }
+
+    if (diff) {
+        /* apply the changes */
+        ly_mod = ly_ctx_get_module_implemented(conn->ly_ctx, mirror->module_name);
+        SR_CHECK_INT_GOTO(!ly_mod, err_info, cleanup);
+        if (!(err_info = sr_lyd_diff_apply_module(&mirror->data, diff, ly_mod, NULL))) {
+            goto cleanup;
+        }
+
+        /* the data are out-of-sync, reload them */
+        SR_LOG_WRN("Failed to update \"%s\" change mirror data, they will be reloaded.", mirror->module_name);
+        sr_errinfo_free(&err_info);
+    }
+
+    /* discard the data */
+    lyd_free_siblings(mirror->data);
+    mirror->data = NULL;
+
+cleanup:
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+    return err_info;
+}
+
+/**
+ * @brief Create a snapshot of change mirror data, only the subtrees selected by the subscription XPath.
+ *
+ * @param[in] mirror Change mirror with loaded data, must be locked.
+ * @param[out] data Snapshot of the mirrored data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_conn_change_mirror_snapshot(const struct sr_change_mirror_s *mirror, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct ly_set *set = NULL;
+    struct lyd_node *dup;
+    uint32_t i;
+
+    *data = NULL;
+
+    if (!mirror->xpath) {
+        /* the whole module is subscribed */
+        return sr_lyd_dup(mirror->data, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, 1, data);
+    }
+
+    /* select the subscribed subtrees */
+    if ((err_info = sr_lyd_find_xpath(mirror->data, mirror->xpath, &set))) {
+        goto cleanup;
+    }
+    if ((err_info = sr_xpath_set_filter_subtrees(set))) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < set->count; ++i) {
+        /* duplicate the subtree with its parents and merge it into the snapshot */
+        if ((err_info = sr_lyd_dup(set->dnodes[i], NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_PARENTS | LYD_DUP_WITH_FLAGS,
+                0, &dup))) {
+            goto cleanup;
+        }
+        while (lyd_parent(dup)) {
+            dup = lyd_parent(dup);
+        }
+        if ((err_info = sr_lyd_merge(data, dup, 0, LYD_MERGE_DESTRUCT))) {
+            lyd_free_tree(dup);
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    ly_set_free(set, NULL);
+    if (err_info) {
+        lyd_free_siblings(*data);
+        *data = NULL;
+    }
+    return err_info;
+}
+
+sr_error_info_t *
+sr_conn_change_mirror_get(sr_conn_ctx_t *conn, uint32_t sub_id, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_change_mirror_s *mirror = NULL;
+    struct lyd_node *new_data = NULL;
+    char *module_name = NULL;
+    sr_datastore_t ds = 0;
+    uint32_t i;
+
+    *data = NULL;
+
+    /* CONN CHANGE MIRROR READ LOCK */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
+            __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    for (i = 0; i < conn->change_mirror_count; ++i) {
+        if (conn->change_mirrors[i].sub_id == sub_id) {
+            mirror = &conn->change_mirrors[i];
+            break;
+        }
+    }
+    if (!mirror) {
+        sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Change subscription with ID \"%" PRIu32 "\" does not mirror data.",
+                sub_id);
+    } else if (mirror->data) {
+        /* copy the data while they cannot be modified */
+        err_info = sr_conn_change_mirror_snapshot(mirror, data);
+    } else {
+        /* remember what to load */
+        module_name = strdup(mirror->module_name);
+        if (!module_name) {
+            SR_ERRINFO_MEM(&err_info);
+        }
+        ds = mirror->ds;
+    }
+
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
+
+    if (err_info || !module_name) {
+        return err_info;
+    }
+
+    /* load the data without holding the lock */
+    if ((err_info = sr_conn_change_mirror_load(conn, module_name, ds, SR_LOCK_READ, &new_data))) {
+        goto cleanup;
+    }
+
+    /* CONN CHANGE MIRROR WRITE LOCK */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        goto cleanup;
+    }
+
+    /* find the mirror again, it may have been moved or deleted */
+    mirror = NULL;
+    for (i = 0; i < conn->change_mirror_count; ++i) {
+        if (conn->change_mirrors[i].sub_id == sub_id) {
+            mirror = &conn->change_mirrors[i];
+            break;
+        }
+    }
+    if (!mirror) {
+        sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Change subscription with ID \"%" PRIu32 "\" does not mirror data.",
+                sub_id);
+    } else {
+        if (!mirror->data) {
+            mirror->data = new_data;
+            new_data = NULL;
+        }
+        err_info = sr_conn_change_mirror_snapshot(mirror, data);
+    }
+
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+
+cleanup:
+    free(module_name);
+    lyd_free_siblings(new_data);
+    return err_info;
+}
+
+/**
+ * @brief Flush all the change mirror data of a connection.
+ *
+ * @param[in] conn Connection to use.
+ */
+static void
+sr_conn_change_mirror_flush(sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+
+    /* CONN CHANGE MIRROR WRITE LOCK */
+    if ((err_info = sr_rwlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        /* should never happen */
+        sr_errinfo_free(&err_info);
+    }
+
+    /* context will be destroyed, the data will be reloaded on demand */
+    for (i = 0; i < conn->change_mirror_count; ++i) {
+        lyd_free_siblings(conn->change_mirrors[i].data);
+        conn->change_mirrors[i].data = NULL;
+    }
+
+    /* CONN CHANGE MIRROR UNLOCK */
+    sr_rwunlock(&conn->change_mirror_lock, SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+}
+
+sr_error_info_t *
+sr_conn_yanglib_cache_get(sr_conn_ctx_t *conn, uint32_t content_id, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    *data = NULL;
+
+    /* CONN YANGLIB CACHE READ LOCK */
+    if ((err_info = sr_rwlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
+            __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    if (conn->yanglib_cache_data && (conn->yanglib_cache_content_id == content_id)) {
+        /* cache hit */
+        err_info = sr_lyd_dup(conn->yanglib_cache_data, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, 1, data);
+    }
+
+    /* CONN YANGLIB CACHE READ UNLOCK */
+    sr_rwunlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
+
+    return err_info;
+}
+
+sr_error_info_t *
+sr_conn_yanglib_cache_update(sr_conn_ctx_t *conn, uint32_t content_id, const struct lyd_node *data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *dup;
+
+    if ((err_info = sr_lyd_dup(data, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, 1, &dup))) {
+        return err_info;
+    }
+
+    /* CONN YANGLIB CACHE WRITE LOCK */
+    if ((err_info = sr_rwlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL))) {
+        lyd_free_siblings(dup);
+        return err_info;
+    }
+
+    /* replace the cached data */
+    lyd_free_siblings(conn->yanglib_cache_data);
+    conn->yanglib_cache_data = dup;
+    conn->yanglib_cache_content_id = content_id;
+
+    /* CONN YANGLIB CACHE WRITE UNLOCK */
+    sr_rwunlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+
+    return NULL;
+}
+
+/**
+ * @brief Flush the cached ietf-yang-library data of a connection.
+ *
+ * @param[in] conn Connection to use.
+ */
+static void
+sr_conn_yanglib_cache_flush(sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+
+    /* CONN YANGLIB CACHE WRITE LOCK */
+    err_info = sr_rwlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
+            __func__, NULL, NULL);
+
+    /* nothing else to do but continue on error, context will be destroyed */
+    lyd_free_siblings(conn->yanglib_cache_data);
+    conn->yanglib_cache_data = NULL;
+    conn->yanglib_cache_content_id = 0;
+
+    if (!err_info) {
+        /* CONN YANGLIB CACHE WRITE UNLOCK */
+        sr_rwunlock(&conn->yanglib_cache_lock, SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
+    }
+
+    sr_errinfo_free(&err_info);
+}
+
 /**
  * @brief Replace cached schema-mount operational data (LY ext data) of a connection.
  *
@@ -3054,9 +3646,10 @@ sr_conn_ext_data_replace(sr_conn_ctx_t *conn, struct lyd_node *new_ext_data)
     err_info = sr_rwlock(&conn->ly_ext_data_lock, SR_CONN_EXT_DATA_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
             NULL, NULL);
 
-    /* replace LY ext data */
+    /* replace LY ext data, they will be rebuilt on the next update */
     lyd_free_siblings(conn->ly_ext_data);
     conn->ly_ext_data = new_ext_data;
+    conn->ly_ext_data_valid = 0;
 
     if (!err_info) {
         /* LY EXT DATA UNLOCK */
@@ -3324,6 +3917,8 @@ sr_conn_ctx_switch(sr_conn_ctx_t *conn, struct ly_ctx **new_ctx, struct ly_ctx *
     sr_conn_ext_data_replace(conn, new_ext_data);
     sr_conn_run_cache_flush(conn);
     sr_conn_oper_cache_flush(conn);
+    sr_conn_change_mirror_flush(conn);
+    sr_conn_yanglib_cache_flush(conn);
 
     /* update content ID */
     conn->content_id = SR_CONN_MAIN_SHM(conn)->content_id;
@@ -4401,7 +4996,8 @@ sr_lyd_get_module_data(struct lyd_node **data, const struct lys_module *ly_mod,
 
             if (add_state_np_conts) {
                 /* add any nested state NP containers */
-                if ((err_info = sr_lyd_new_implicit_tree(subtree, LYD_IMPLICIT_NO_CONFIG | LYD_IMPLICIT_NO_DEFAULTS))) {
+                if ((err_info = sr_lyd_new_implicit_tree(subtree, LYD_IMPLICIT_NO_CONFIG | LYD_IMPLICIT_NO_DEFAULTS,
+                        NULL))) {
                     return err_info;
                 }
             }
@@ -4551,7 +5147,7 @@ sr_lyd_get_enabled_xpath(struct lyd_node **data, char **xpaths, uint16_t xp_coun
         }
 
         /* add any state NP containers */
-        if ((err_info = sr_lyd_new_implicit_tree(root, LYD_IMPLICIT_NO_DEFAULTS))) {
+        if ((err_info = sr_lyd_new_implicit_tree(root, LYD_IMPLICIT_NO_DEFAULTS, NULL))) {
             goto cleanup;
         }
 
@@ -4647,6 +5243,40 @@ sr_str_hash(const char *str, uint32_t priority)
     return hash;
 }
 
+/*
+ * Two independent 64-bit hashes, FNV-1a and a multiplicative hash with a xor-shift finalizer (both over the bytes
+ * and the length).
+ */
+void
+sr_mem_digest(const void *mem, size_t len, uint64_t digest[2])
+{
+    const uint8_t *bytes = mem;
+    uint64_t h1 = 0xcbf29ce484222325ULL, h2 = 0x9e3779b97f4a7c15ULL;
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        h1 ^= bytes[i];
+        h1 *= 0x100000001b3ULL;
+
+        h2 += bytes[i];
+        h2 *= 0xbf58476d1ce4e5b9ULL;
+        h2 ^= h2 >> 31;
+    }
+    h1 ^= len;
+    h1 *= 0x100000001b3ULL;
+    h2 += len;
+    h2 ^= h2 >> 30;
+    h2 *= 0x94d049bb133111ebULL;
+    h2 ^= h2 >> 31;
+
+    if (!h1 && !h2) {
+        /* reserved for no digest */
+        h1 = 1;
+    }
+    digest[0] = h1;
+    digest[1] = h2;
+}
+
 sr_error_info_t *
 sr_xpath_trim_last_node(const char *xpath, char **trim_xpath)
 {
@@ -4846,6 +5476,72 @@ sr_xpath_skip_predicate(const char *xpath)
     return xpath + 1;
 }
 
+int
+sr_xpath_is_simple_path(const char *xpath, const char **mod, int *mod_len)
+{
+    const char *ptr, *name, *lit_end, *step_mod;
+    int len, step_mod_len;
+
+    *mod = NULL;
+    *mod_len = 0;
+
+    ptr = xpath;
+    if (ptr[0] != '/') {
+        /* relative */
+        return 0;
+    }
+
+    while (ptr[0]) {
+        if ((ptr[0] != '/') || (ptr[1] == '/')) {
+            /* not a child step */
+            return 0;
+        }
+
+        /* node name, the first one must be prefixed */
+        if (!*mod) {
+            ptr = sr_xpath_next_qname(ptr + 1, mod, mod_len, &name, &len);
+            if (!*mod) {
+                return 0;
+            }
+        } else {
+            ptr = sr_xpath_next_qname(ptr + 1, &step_mod, &step_mod_len, &name, &len);
+            if (step_mod && ((step_mod_len != *mod_len) || strncmp(step_mod, *mod, *mod_len))) {
+                /* foreign (augment) node, data of another module */
+                return 0;
+            }
+        }
+        if (!len || (!isalpha(name[0]) && (name[0] != '_'))) {
+            /* wildcard, self, parent, or a function */
+            return 0;
+        }
+
+        /* only key and leaf-list value equality predicates */
+        while (ptr[0] == '[') {
+            ++ptr;
+            if (ptr[0] == '.') {
+                ++ptr;
+            } else {
+                ptr = sr_xpath_next_qname(ptr, NULL, NULL, &name, &len);
+                if (!len || (!isalpha(name[0]) && (name[0] != '_'))) {
+                    return 0;
+                }
+            }
+            if ((ptr[0] != '=') || ((ptr[1] != '\'') && (ptr[1] != '\"'))) {
+                return 0;
+            }
+
+            /* literal */
+            lit_end = strchr(ptr + 2, ptr[1]);
+            if (!lit_end || (lit_end[1] != ']')) {
+                return 0;
+            }
+            ptr = lit_end + 2;
+        }
+    }
+
+    return 1;
+}
+
 int
 sr_xpath_refs_mod(const char *xpath, const char *mod_name)
 {
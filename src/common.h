@@ -66,6 +66,12 @@ struct srplg_ntf_s;
 /** all ext SHM item sizes will be aligned to this number; also represents the allocation unit (B) */
 #define SR_SHM_MEM_ALIGN 8
 
+/** minimal used SHM size for its mapping to be backed by huge pages, if enabled (B) */
+#define SR_SHM_HUGE_PAGE_MIN_SIZE (2 * 1024 * 1024)
+
+/** address space reserved for ext SHM mapping so that it can grow without being remapped (B) */
+#define SR_EXT_SHM_RESERVE_SIZE (256 * 1024 * 1024)
+
 /** timeout for locking subscription structure lock, should be enough for a single ::sr_process_events() call (ms) */
 #define SR_SUBSCR_LOCK_TIMEOUT 30000
 
@@ -87,6 +93,9 @@ struct srplg_ntf_s;
 /** timeout for locking the local connection list; maximum time the list can be accessed (ms) */
 #define SR_CONN_LIST_LOCK_TIMEOUT 100
 
+/** maximum time a connection found alive is considered alive without checking its lockfile again (ms) */
+#define SR_CONN_ALIVE_CACHE_TIMEOUT 1000
+
 /** timeout for locking connection remap lock; maximum time it can be continuously read/written to (ms) */
 #define SR_CONN_REMAP_LOCK_TIMEOUT 10000
 
@@ -99,6 +108,12 @@ struct srplg_ntf_s;
 /** timeout for write-locking connection subscription oper cache data (ms) */
 #define SR_CONN_OPER_CACHE_DATA_LOCK_TIMEOUT 1000
 
+/** timeout for locking connection change mirrors (ms) */
+#define SR_CONN_CHANGE_MIRROR_LOCK_TIMEOUT 1000
+
+/** timeout for accessing connection cached ietf-yang-library data (duplication) (ms) */
+#define SR_CONN_YANGLIB_CACHE_LOCK_TIMEOUT 100
+
 /** timeout for accessing stored connection ext data (duplication) (ms) */
 #define SR_CONN_EXT_DATA_LOCK_TIMEOUT 100
 
@@ -126,6 +141,12 @@ struct srplg_ntf_s;
 /** default timeout for notification subscrption callback (ms) */
 #define SR_NOTIF_CB_TIMEOUT 2000
 
+/** time without new done events after which a coalescing change subscription delivers the accumulated ones (ms) */
+#define SR_CHANGE_COALESCE_IDLE_TIMEOUT 50
+
+/** maximum number of done events a coalescing change subscription accumulates before delivering them when idle */
+#define SR_CHANGE_COALESCE_IDLE_MAX_COUNT 1000
+
 /** timeout step for parallel subscription active polling loop */
 #define SR_SHMSUB_MANY_EVENT_TIMEOUT_STEP_MS 1
 
@@ -186,7 +207,7 @@ extern const sr_module_ds_t sr_module_ds_default;
 extern const sr_module_ds_t sr_module_ds_disabled_run;
 
 /** static initializer of the shared memory structure */
-#define SR_SHM_INITIALIZER {.fd = -1, .size = 0, .addr = NULL}
+#define SR_SHM_INITIALIZER {.fd = -1, .size = 0, .map_size = 0, .reserve_size = 0, .huge_pages = 0, .addr = NULL}
 
 /** initializer of mod_info structure */
 #define SR_MODINFO_INIT(mi, c, d, d2) memset(&(mi), 0, sizeof (mi)); (mi).ds = (d); (mi).ds2 = (d2); (mi).conn = (c)
@@ -241,6 +262,14 @@ typedef struct {
 sr_error_info_t *_sr_session_start(sr_conn_ctx_t *conn, const sr_datastore_t datastore, sr_sub_event_t event,
         char **shm_data_ptr, sr_session_ctx_t **session);
 
+/**
+ * @brief Parse all the remaining lazily-parsed subtrees of an event session diff.
+ *
+ * @param[in] session Event session.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_session_ev_diff_materialize(sr_session_ctx_t *session);
+
 /**
  * @brief Notify subscribers about the changes in diff and store the data in mod info.
  * Mod info modules are expected to be READ-locked with the ability to upgrade to WRITE-lock!
@@ -593,7 +622,7 @@ int sr_time_sub_ms(const struct timespec *ts1, const struct timespec *ts2);
 
 /**
  * @brief Remap and possibly resize a SHM. Needs WRITE lock for resizing,
- * otherwise READ lock is fine.
+ * otherwise READ lock is fine. If the current mapping is large enough, only the size is adjusted.
  *
  * @param[in] shm SHM structure to remap.
  * @param[in] new_shm_size Resize SHM to this size, if 0 read the size of the SHM file.
@@ -799,6 +828,17 @@ sr_error_info_t *sr_rwlock_init(sr_rwlock_t *rwlock, int shared);
  */
 void sr_rwlock_destroy(sr_rwlock_t *rwlock);
 
+/**
+ * @brief Wait on a condition of a sysrepo RW lock until woken by an unlock.
+ * Mutex must be held!
+ *
+ * @param[in] rwlock RW lock to wait on.
+ * @param[in] wait_type Type of the waiter.
+ * @param[in] timeout_abs Absolute timeout for waiting.
+ * @return errno
+ */
+int sr_rwlock_cond_wait(sr_rwlock_t *rwlock, sr_rwlock_wait_t wait_type, struct timespec *timeout_abs);
+
 /**
  * @brief Lock a sysrepo RW lock with additional options for sub SHM. On failure, the lock is not changed in any way.
  *
@@ -871,11 +911,21 @@ int sr_conn_is_alive(sr_cid_t cid);
 /**
  * @brief Update cached schema-mount operational data (LY ext data) of a connection.
  *
+ * The data are not rebuilt if neither the context nor schema-mount operational data changed since the last update.
+ *
  * @param[in] conn Connection to use.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_conn_ext_data_update(sr_conn_ctx_t *conn);
 
+/**
+ * @brief Mark schema-mount operational data as changed so that all connections rebuild their LY ext data.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod_name Name of the module whose operational data changed, ignored unless ietf-yang-schema-mount.
+ */
+void sr_conn_ext_data_changed(sr_conn_ctx_t *conn, const char *mod_name);
+
 /**
  * @brief Add a new oper cache entry into a connection.
  *
@@ -895,6 +945,68 @@ sr_error_info_t *sr_conn_oper_cache_add(sr_conn_ctx_t *conn, uint32_t sub_id, co
  */
 void sr_conn_oper_cache_del(sr_conn_ctx_t *conn, uint32_t sub_id);
 
+/**
+ * @brief Add a new change mirror entry into a connection and load its data.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] sub_id Subscription ID of the change subscription.
+ * @param[in] ly_mod Subscription module.
+ * @param[in] xpath Subscription XPath, NULL for the whole module.
+ * @param[in] ds Subscription datastore.
+ * @param[in] mod_locked Whether the module is already READ-locked.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_conn_change_mirror_add(sr_conn_ctx_t *conn, uint32_t sub_id, const struct lys_module *ly_mod,
+        const char *xpath, sr_datastore_t ds, int mod_locked);
+
+/**
+ * @brief Delete a change mirror entry in a connection, if any.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] sub_id Subscription ID to delete.
+ */
+void sr_conn_change_mirror_del(sr_conn_ctx_t *conn, uint32_t sub_id);
+
+/**
+ * @brief Update change mirror data with a diff.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] sub_id Subscription ID of the mirror.
+ * @param[in] diff Diff of the changes to apply, if NULL the data are discarded and will be reloaded.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_conn_change_mirror_update(sr_conn_ctx_t *conn, uint32_t sub_id, const struct lyd_node *diff);
+
+/**
+ * @brief Get a copy of change mirror data selected by the subscription XPath, load them if needed.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] sub_id Subscription ID of the mirror.
+ * @param[out] data Copy of the mirrored data, to be freed by the caller.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_conn_change_mirror_get(sr_conn_ctx_t *conn, uint32_t sub_id, struct lyd_node **data);
+
+/**
+ * @brief Get a copy of the cached ietf-yang-library data of a connection.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] content_id Context content ID the data must have been generated for.
+ * @param[out] data Duplicated cached data, NULL if not cached.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_conn_yanglib_cache_get(sr_conn_ctx_t *conn, uint32_t content_id, struct lyd_node **data);
+
+/**
+ * @brief Update the cached ietf-yang-library data of a connection.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] content_id Context content ID @p data were generated for.
+ * @param[in] data Generated data to cache, are duplicated.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_conn_yanglib_cache_update(sr_conn_ctx_t *conn, uint32_t content_id, const struct lyd_node *data);
+
 /**
  * @brief Update cached running data of a connection.
  *
@@ -1222,6 +1334,15 @@ sr_error_info_t *sr_lyd_xpath_complement(struct lyd_node **data, const char *xpa
  */
 uint32_t sr_str_hash(const char *str, uint32_t priority);
 
+/**
+ * @brief Get a 128-bit digest of a memory block. It is not a cryptographic digest but it is never all zeros.
+ *
+ * @param[in] mem Memory to digest.
+ * @param[in] len Length of @p mem.
+ * @param[out] digest Digest of @p mem.
+ */
+void sr_mem_digest(const void *mem, size_t len, uint64_t digest[2]);
+
 /**
  * @brief Trim last node from an XPath.
  *
@@ -1267,6 +1388,17 @@ const char *sr_xpath_next_qname(const char *xpath, const char **mod, int *mod_le
  */
 const char *sr_xpath_skip_predicate(const char *xpath);
 
+/**
+ * @brief Check whether an XPath is a simple absolute path with only child steps and key or leaf-list value
+ * equality predicates so that it can be resolved without the XPath engine.
+ *
+ * @param[in] xpath XPath to check.
+ * @param[out] mod Module name of the first node.
+ * @param[out] mod_len Module name length.
+ * @return Whether the XPath is a simple path or not.
+ */
+int sr_xpath_is_simple_path(const char *xpath, const char **mod, int *mod_len);
+
 /**
  * @brief Check whether an XPath references any nodes of a module.
  *
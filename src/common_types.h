@@ -35,6 +35,10 @@
 typedef struct {
     int fd;                         /**< Shared memory file desriptor. */
     size_t size;                    /**< Shared memory mapping current size. */
+    size_t map_size;                /**< Length of the mapping, may be larger than size. */
+    size_t reserve_size;            /**< Length of the mapping to reserve so that the SHM can grow without being
+                                         remapped, 0 to always map only the current size. */
+    int huge_pages;                 /**< Whether to back the mapping with huge pages, if large enough and enabled. */
     char *addr;                     /**< Shared memory mapping address. */
 } sr_shm_t;
 
@@ -52,12 +56,26 @@ typedef enum {
 /** maximum number of system-wide concurrent connection owners of a read lock */
 #define SR_RWLOCK_READ_LIMIT 16
 
+/**
+ * @brief Type of a waiter on a sysrepo read-write lock, decides which waiters are woken on unlock.
+ */
+typedef enum {
+    SR_RWLOCK_WAIT_READ = 0,        /**< Waiting for a READ or READ-UPGR lock. */
+    SR_RWLOCK_WAIT_WRITE,           /**< Waiting for a free WRITE lock, any single such waiter can be woken. */
+    SR_RWLOCK_WAIT_WRITE_ALL        /**< Waiting for a specific lock state (urged WRITE lock, upgrade, sub SHM event),
+                                         all such waiters must always be woken. */
+} sr_rwlock_wait_t;
+
 /**
  * @brief Sysrepo read-write lock.
  */
 typedef struct {
     pthread_mutex_t mutex;          /**< Lock mutex. */
-    sr_cond_t cond;                 /**< Lock condition variable. */
+    sr_cond_t cond;                 /**< Lock condition variable of readers. */
+    sr_cond_t wr_cond;              /**< Lock condition variable of writers. */
+    uint32_t rd_waiters;            /**< Number of ::SR_RWLOCK_WAIT_READ waiters on cond. */
+    uint32_t wr_waiters;            /**< Number of ::SR_RWLOCK_WAIT_WRITE waiters on wr_cond. */
+    uint32_t wr_all_waiters;        /**< Number of ::SR_RWLOCK_WAIT_WRITE_ALL waiters on wr_cond. */
 
     sr_cid_t readers[SR_RWLOCK_READ_LIMIT]; /**< CIDs of all READ lock owners (including READ-UPGR), 0s otherwise. */
     uint8_t read_count[SR_RWLOCK_READ_LIMIT];   /**< Number of recursive read locks of the connection in readers. */
@@ -127,9 +145,16 @@ struct sr_conn_ctx_s {
     sr_cid_t cid;                   /**< Globally unique connection ID */
     sr_rwlock_t ly_ext_data_lock;   /**< Session-shared lock for accessing ly_ext_data. */
     struct lyd_node *ly_ext_data;   /**< Data for LY ext data callback set for ly_ctx. */
+    uint32_t ly_ext_data_content_id;    /**< Context content ID of ly_ext_data. */
+    uint32_t ly_ext_data_sm_ver;    /**< Schema-mount data version (of main SHM) of ly_ext_data. */
+    int ly_ext_data_valid;          /**< Whether ly_ext_data can be reused while the content ID and version match. */
 
     int create_lock;                /**< Process-shared file lock for creating main/mod/ext SHM. */
     sr_shm_t main_shm;              /**< Main SHM structure. */
+    pthread_mutex_t ctx_read_lock;  /**< Session-shared lock for the shared main SHM context READ lock. */
+    uint32_t ctx_read_count;        /**< Number of holders of the main SHM context READ lock shared by this connection. */
+    uint32_t ctx_read_sep_count;    /**< Number of separate main SHM context READ locks held by this connection while
+                                         a context change was pending. */
     sr_rwlock_t mod_remap_lock;     /**< Session-shared lock only for remapping mod SHM. */
     sr_shm_t mod_shm;               /**< Mod SHM structure. */
     sr_rwlock_t ext_remap_lock;     /**< Session-shared lock only for remapping ext SHM. */
@@ -168,6 +193,20 @@ struct sr_conn_ctx_s {
     } *oper_caches;                 /**< Operational get subscription data caches. */
     uint32_t oper_cache_count;      /**< Operational get subscription data cache count. */
     sr_rwlock_t oper_cache_lock;    /**< Operational get subscription data cache lock. */
+
+    struct sr_change_mirror_s {
+        uint32_t sub_id;            /**< Mirrored change subscription ID. */
+        char *module_name;          /**< Mirrored module name. */
+        char *xpath;                /**< Subscription XPath selecting the data provided to the callbacks, if any. */
+        sr_datastore_t ds;          /**< Mirrored datastore. */
+        struct lyd_node *data;      /**< Mirrored data of the module, NULL if not loaded. */
+    } *change_mirrors;              /**< Change subscription data mirrors. */
+    uint32_t change_mirror_count;   /**< Change subscription data mirror count. */
+    sr_rwlock_t change_mirror_lock; /**< Change subscription data mirror lock. */
+
+    struct lyd_node *yanglib_cache_data;    /**< Cached generated ietf-yang-library data. */
+    uint32_t yanglib_cache_content_id;      /**< Context content ID of the cached ietf-yang-library data. */
+    sr_rwlock_t yanglib_cache_lock; /**< Lock for accessing the cached ietf-yang-library data. */
 };
 
 /**
@@ -190,6 +229,10 @@ struct sr_session_ctx_s {
     struct {
         char *orig_name;            /**< Set originator name by the event originator. */
         void *orig_data;            /**< Set originator data by the event originator. */
+        void *diff_lazy;            /**< Not yet parsed top-level subtrees of the event diff (LYB chunks
+                                         prefixed by their "module:name"), see ::sr_session_ev_diff_materialize(). */
+        struct lyd_node *mirror;    /**< Copy of the change mirror data provided to the callback, if requested. */
+        uint32_t mirror_sub_id;     /**< Subscription ID of the change mirror data copy. */
     } ev_data;                      /**< Event data from the originator. Valid only if ev is not ::SR_SUB_EV_NONE. */
     sr_error_info_t *ev_err_info;   /**< Event error info for the originator. */
 
@@ -244,6 +287,14 @@ struct sr_subscription_ctx_s {
             ATOMIC_T request_id;    /**< Request ID of the last processed request. */
             ATOMIC_T event;         /**< Type of the last processed event. */
             ATOMIC_T suspended;     /**< Whether the subscription is suspended. */
+
+            uint32_t coalesce_ms;   /**< Window for accumulating done events, 0 to deliver them once idle. */
+            char *coalesce_lyb;     /**< Merged diff of the accumulated done events in LYB, if any. Kept printed
+                                         so that it does not depend on the connection context. */
+            uint32_t coalesce_request_id;   /**< Request ID of the last accumulated done event. */
+            uint32_t coalesce_count;        /**< Number of accumulated done events. */
+            struct timespec coalesce_since; /**< Timestamp of the first accumulated done event. */
+            struct timespec coalesce_last;  /**< Timestamp of the last accumulated done event. */
         } *subs;                    /**< Configuration change subscriptions for each XPath. */
         uint32_t sub_count;         /**< Configuration change module XPath subscription count. */
 
@@ -288,6 +339,8 @@ struct sr_subscription_ctx_s {
         struct modsub_notifsub_s {
             uint32_t sub_id;        /**< Unique subscription ID. */
             char *xpath;            /**< Subscription XPath. */
+            char **notif_paths;     /**< Schema paths of all the notifications the XPath can select, NULL if unknown. */
+            uint32_t notif_path_count;  /**< Count of notification paths. */
             struct timespec listen_since_mono;  /**< Monotonic timestamp of the subscription listening for real-time notifications. */
             struct timespec listen_since_real;  /**< Realtime timestamp of the subscription listening for real-time notifications. */
             struct timespec start_time; /**< Subscription start time. */
@@ -39,6 +39,117 @@
 #include "sysrepo.h"
 #include "sysrepo_types.h"
 
+/**
+ * @brief Lock main SHM context lock. READ lock is shared by the concurrent threads of a connection so only the first
+ * one actually locks the main SHM lock. If a context change is pending, new readers lock the main SHM lock
+ * themselves so that the shared lock can be released.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mode Requested lock mode.
+ * @param[in] func Caller function name for logging.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_lycc_context_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, const char *func)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_main_shm_t *main_shm = SR_CONN_MAIN_SHM(conn);
+    int shared;
+
+    if (mode != SR_LOCK_READ) {
+        /* CONTEXT LOCK */
+        return sr_rwlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, mode, conn->cid, func, NULL, NULL);
+    }
+
+    /* CTX READ LOCK */
+    if ((err_info = sr_mlock(&conn->ctx_read_lock, SR_CONTEXT_LOCK_TIMEOUT, func, NULL, NULL))) {
+        return err_info;
+    }
+
+    /* join the shared lock only if no context change is pending, otherwise it may never be released */
+    shared = conn->ctx_read_count && !main_shm->context_lock.upgr && !main_shm->context_lock.writer;
+    if (shared) {
+        ++conn->ctx_read_count;
+    }
+
+    /* CTX READ UNLOCK */
+    sr_munlock(&conn->ctx_read_lock);
+
+    if (shared) {
+        return NULL;
+    }
+
+    /* CONTEXT LOCK, waits for any writer */
+    if ((err_info = sr_rwlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, func, NULL,
+            NULL))) {
+        return err_info;
+    }
+
+    /* CTX READ LOCK */
+    if ((err_info = sr_mlock(&conn->ctx_read_lock, SR_CONTEXT_LOCK_TIMEOUT, func, NULL, NULL))) {
+        /* CONTEXT UNLOCK */
+        sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, func);
+        return err_info;
+    }
+
+    if (!conn->ctx_read_count) {
+        /* becomes the shared lock */
+        ++conn->ctx_read_count;
+    } else {
+        /* kept as a separate lock */
+        ++conn->ctx_read_sep_count;
+    }
+
+    /* CTX READ UNLOCK */
+    sr_munlock(&conn->ctx_read_lock);
+    return NULL;
+}
+
+/**
+ * @brief Unlock main SHM context lock locked by ::sr_lycc_context_lock().
+ *
+ * All the READ locks of a connection are held with the same CID so any thread can release any of them. The shared
+ * lock is released first so that a pending context change is not blocked by it.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mode Lock mode.
+ * @param[in] func Caller function name for logging.
+ */
+static void
+sr_lycc_context_unlock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, const char *func)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_main_shm_t *main_shm = SR_CONN_MAIN_SHM(conn);
+
+    if (mode != SR_LOCK_READ) {
+        /* CONTEXT UNLOCK */
+        sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, mode, conn->cid, func);
+        return;
+    }
+
+    /* CTX READ LOCK */
+    if ((err_info = sr_mlock(&conn->ctx_read_lock, SR_CONTEXT_LOCK_TIMEOUT, func, NULL, NULL))) {
+        sr_errinfo_free(&err_info);
+        return;
+    }
+
+    assert(conn->ctx_read_count || conn->ctx_read_sep_count);
+    if (conn->ctx_read_count) {
+        if (!--conn->ctx_read_count) {
+            /* CONTEXT UNLOCK */
+            sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, func);
+        }
+    } else {
+        --conn->ctx_read_sep_count;
+
+        /* CONTEXT UNLOCK */
+        sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, func);
+    }
+
+    /* CTX READ UNLOCK */
+    sr_munlock(&conn->ctx_read_lock);
+}
+
 sr_error_info_t *
 sr_lycc_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int lydmods_lock, const char *func)
 {
@@ -49,7 +160,7 @@ sr_lycc_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int lydmods_lock, const c
     char *path;
 
     /* CONTEXT LOCK */
-    if ((err_info = sr_rwlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, mode, conn->cid, func, NULL, NULL))) {
+    if ((err_info = sr_lycc_context_lock(conn, mode, func))) {
         return err_info;
     }
 
@@ -126,7 +237,7 @@ cleanup_unlock:
             sr_rwunlock(&conn->mod_remap_lock, SR_CONN_REMAP_LOCK_TIMEOUT, remap_mode, conn->cid, func);
         }
         /* CONTEXT UNLOCK */
-        sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, mode, conn->cid, func);
+        sr_lycc_context_unlock(conn, mode, func);
     }
     return err_info;
 }
@@ -164,7 +275,7 @@ sr_lycc_unlock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int lydmods_lock, const
     sr_rwunlock(&conn->mod_remap_lock, SR_CONN_REMAP_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, func);
 
     /* CONTEXT UNLOCK */
-    sr_rwunlock(&main_shm->context_lock, SR_CONTEXT_LOCK_TIMEOUT, mode, conn->cid, func);
+    sr_lycc_context_unlock(conn, mode, func);
 }
 
 sr_error_info_t *
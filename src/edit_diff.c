@@ -3400,6 +3400,88 @@ error_safe:
     return err_info;
 }
 
+/**
+ * @brief Collect diff nodes of schema nodes from diff siblings, recursively.
+ *
+ * @param[in] first First diff sibling.
+ * @param[in] snodes Array of schema nodes.
+ * @param[in] snode_count Count of @p snodes.
+ * @param[in,out] sets Array of sets to add to.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_diff_snodes_collect_r(const struct lyd_node *first, const struct lysc_node **snodes, uint32_t snode_count,
+        struct ly_set **sets)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *sibling, *elem;
+    const struct lysc_node *parent;
+    uint32_t i;
+    int descend;
+
+    LY_LIST_FOR(first, sibling) {
+        if (!sibling->schema) {
+            /* opaque node */
+            continue;
+        }
+
+        descend = 0;
+        for (i = 0; i < snode_count; ++i) {
+            if (sibling->schema == snodes[i]) {
+                /* collect the whole subtree */
+                LYD_TREE_DFS_BEGIN(sibling, elem) {
+                    if ((err_info = sr_ly_set_add(sets[i], (void *)elem))) {
+                        return err_info;
+                    }
+                    LYD_TREE_DFS_END(sibling, elem);
+                }
+            } else if (!descend) {
+                /* is there another schema node in the subtree */
+                for (parent = snodes[i]->parent; parent && (parent != sibling->schema); parent = parent->parent) {}
+                if (parent) {
+                    descend = 1;
+                }
+            }
+        }
+
+        if (descend && (err_info = sr_diff_snodes_collect_r(lyd_child(sibling), snodes, snode_count, sets))) {
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_diff_snodes_collect(const struct lyd_node *diff, const struct lysc_node **snodes, uint32_t snode_count,
+        struct ly_set **sets)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+
+    memset(sets, 0, snode_count * sizeof *sets);
+
+    for (i = 0; i < snode_count; ++i) {
+        if ((err_info = sr_ly_set_new(&sets[i]))) {
+            goto cleanup;
+        }
+    }
+
+    /* single traversal of the diff, only the subtrees leading to the schema nodes are visited */
+    if ((err_info = sr_diff_snodes_collect_r(diff, snodes, snode_count, sets))) {
+        goto cleanup;
+    }
+
+cleanup:
+    if (err_info) {
+        for (i = 0; i < snode_count; ++i) {
+            ly_set_free(sets[i], NULL);
+            sets[i] = NULL;
+        }
+    }
+    return err_info;
+}
+
 sr_error_info_t *
 sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, sr_change_oper_t *op)
 {
@@ -205,4 +205,19 @@ sr_error_info_t *sr_edit_add(sr_session_ctx_t *session, const char *xpath, const
  */
 sr_error_info_t *sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, sr_change_oper_t *op);
 
+/**
+ * @brief Collect nodes from a sysrepo diff grouped by schema nodes in a single traversal.
+ *
+ * For each schema node, all its data instances with all their descendants are collected in a separate set,
+ * the same as if selected by the XPath `<schema-path>//.` except for the predicates.
+ *
+ * @param[in] diff Sysrepo diff.
+ * @param[in] snodes Array of schema nodes.
+ * @param[in] snode_count Count of @p snodes.
+ * @param[out] sets Array of @p snode_count created sets with the diff nodes of each schema node, in the same order.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_diff_snodes_collect(const struct lyd_node *diff, const struct lysc_node **snodes,
+        uint32_t snode_count, struct ly_set **sets);
+
 #endif
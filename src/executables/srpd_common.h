@@ -17,6 +17,7 @@
 #ifndef _SRPD_COMMON_H
 #define _SRPD_COMMON_H
 
+#include <stdint.h>
 #include <sys/types.h>
 
 #include "sysrepo_types.h"
@@ -31,8 +32,11 @@ struct srpd_plugin_s {
     void *handle;
     srp_init_cb_t init_cb;
     srp_cleanup_cb_t cleanup_cb;
+    const char **init_deps;     /**< optional NULL-terminated array of plugins to initialize before this one */
     void *private_data;
     char *plugin_name;
+    sr_session_ctx_t *sess;     /**< session the plugin was initialized with */
+    uint64_t init_time;         /**< duration of the plugin initialization in microseconds */
     int initialized;
 };
 
@@ -79,6 +83,16 @@ int srpd_exec(const char *plugin_name, const char *cmd, uint32_t num_of_args, ..
  */
 void srpd_swap(struct srpd_plugin_s *a, struct srpd_plugin_s *b);
 
+/**
+ * @brief Compares plugin name with a name that may include the filename extension.
+ *
+ * @param[in] plugin Plugin to compare.
+ * @param[in] str2 Name to compare with.
+ * @return 0 if the names match.
+ * @return non-zero if the names differ.
+ */
+int srpd_plugin_names_cmp(const struct srpd_plugin_s *plugin, const char *str2);
+
 /**
  * @brief Sorts plugins.
  *
@@ -86,9 +100,11 @@ void srpd_swap(struct srpd_plugin_s *a, struct srpd_plugin_s *b);
  * @param[in] plugins Array of plugins to be sorted.
  * @param[in] plugin_count Number of plugins within the array.
  * @param[in] plugin_name Name of the plugin.
+ * @param[out] ordered_count Optional number of plugins at the beginning of @p plugins with a user-defined order.
  * @return SR_ERR_OK on success.
  */
-int srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name);
+int srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name,
+        int *ordered_count);
 
 /*
  * plugins
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <getopt.h>
+#include <inttypes.h>
 #include <pthread.h>
 #include <signal.h>
 #include <stdarg.h>
@@ -32,6 +33,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "bin_common.h"
@@ -52,6 +54,33 @@ pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
 /** The name of the configuration module for the sysrepo-plugind program itself. */
 #define SRPD_MODULE_NAME "sysrepo-plugind"
 
+/**
+ * @brief Plugin initialization state.
+ */
+enum srpd_init_state_e {
+    SRPD_INIT_WAITING = 0,
+    SRPD_INIT_RUNNING,
+    SRPD_INIT_DONE
+};
+
+/**
+ * @brief Shared context of parallel plugin initialization.
+ */
+struct srpd_init_s {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    sr_conn_ctx_t *conn;
+    struct srpd_plugin_s *plugins;
+    int plugin_count;
+    int ordered_count;                  /**< number of plugins with a user-defined order */
+    enum srpd_init_state_e *state;      /**< initialization state of each plugin */
+    int running;                        /**< number of plugins being initialized */
+    int remaining;                      /**< number of plugins waiting for initialization */
+    int fatal_fail;
+    int abort;                          /**< no more plugins are to be initialized */
+    int rc;
+};
+
 /**
  * @brief An array of internal plugins
  */
@@ -356,6 +385,9 @@ load_plugins(struct srpd_plugin_s **plugins, int *plugin_count)
             break;
         }
 
+        /* optional dependencies */
+        plugin->init_deps = dlsym(handle, SRP_INIT_DEPS);
+
         /* finally store the plugin */
         plugin->handle = handle;
 
@@ -382,11 +414,212 @@ load_plugins(struct srpd_plugin_s **plugins, int *plugin_count)
     return rc;
 }
 
+static int
+get_init_threads(sr_session_ctx_t *sess, uint32_t *threads)
+{
+    const char *xpath = "/sysrepo-plugind:sysrepo-plugind/plugin-init/threads";
+    sr_val_t *val;
+    int r;
+
+    *threads = 1;
+
+    if ((r = sr_get_item(sess, xpath, 0, &val))) {
+        if (r == SR_ERR_NOT_FOUND) {
+            /* default */
+            return SR_ERR_OK;
+        }
+        SRPLG_LOG_ERR("sysrepo-plugind", "Getting \"%s\" failed (%s).", xpath, sr_strerror(r));
+        return r;
+    }
+
+    *threads = val->data.uint16_val;
+    sr_free_val(val);
+    return SR_ERR_OK;
+}
+
+static int
+init_plugin(sr_session_ctx_t *sess, struct srpd_plugin_s *plugin)
+{
+    struct timespec start, end;
+    int r;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    r = plugin->init_cb(sess, &plugin->private_data);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    plugin->init_time = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+    if (r) {
+        SRPLG_LOG_ERR("sysrepo-plugind", "Plugin \"%s\" initialization failed (%s).", plugin->plugin_name,
+                sr_strerror(r));
+    } else {
+        SRPLG_LOG_INF("sysrepo-plugind", "Plugin \"%s\" initialized (%" PRIu64 " us).", plugin->plugin_name,
+                plugin->init_time);
+        plugin->sess = sess;
+        plugin->initialized = 1;
+    }
+
+    return r;
+}
+
+static int
+init_plugin_is_ready(struct srpd_init_s *init, int idx)
+{
+    const char **dep;
+    int i;
+
+    if (init->state[idx] != SRPD_INIT_WAITING) {
+        return 0;
+    }
+
+    /* plugins with a user-defined order are initialized one after another and all the other plugins only after them */
+    if ((idx > 0) && (idx < init->ordered_count) && (init->state[idx - 1] != SRPD_INIT_DONE)) {
+        return 0;
+    } else if ((idx >= init->ordered_count) && init->ordered_count &&
+            (init->state[init->ordered_count - 1] != SRPD_INIT_DONE)) {
+        return 0;
+    }
+
+    /* declared dependencies */
+    for (dep = init->plugins[idx].init_deps; dep && *dep; ++dep) {
+        for (i = 0; i < init->plugin_count; ++i) {
+            if ((i != idx) && !srpd_plugin_names_cmp(&init->plugins[i], *dep) && (init->state[i] != SRPD_INIT_DONE)) {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void *
+init_plugins_thread(void *arg)
+{
+    struct srpd_init_s *init = arg;
+    sr_session_ctx_t *sess;
+    int i, r;
+
+    /* the session is kept for the plugins initialized with it, it is stopped by sr_disconnect() */
+    if ((r = sr_session_start(init->conn, SR_DS_RUNNING, &sess))) {
+        SRPLG_LOG_ERR("sysrepo-plugind", "Failed to start new session (%s).", sr_strerror(r));
+        pthread_mutex_lock(&init->lock);
+        init->abort = 1;
+        init->rc = -1;
+        pthread_cond_broadcast(&init->cond);
+        pthread_mutex_unlock(&init->lock);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&init->lock);
+    while (!init->abort && init->remaining) {
+        /* find a plugin that can be initialized, prefer the sorted order */
+        for (i = 0; i < init->plugin_count; ++i) {
+            if (init_plugin_is_ready(init, i)) {
+                break;
+            }
+        }
+
+        if (i == init->plugin_count) {
+            if (!init->running) {
+                /* nothing is being initialized and nothing can be */
+                SRPLG_LOG_ERR("sysrepo-plugind", "Plugin initialization dependency cycle detected.");
+                init->abort = 1;
+                init->rc = -1;
+                pthread_cond_broadcast(&init->cond);
+                break;
+            }
+
+            /* wait for another plugin to finish */
+            pthread_cond_wait(&init->cond, &init->lock);
+            continue;
+        }
+
+        init->state[i] = SRPD_INIT_RUNNING;
+        ++init->running;
+        --init->remaining;
+        pthread_mutex_unlock(&init->lock);
+
+        r = init_plugin(sess, &init->plugins[i]);
+
+        pthread_mutex_lock(&init->lock);
+        init->state[i] = SRPD_INIT_DONE;
+        --init->running;
+        if (r && init->fatal_fail) {
+            init->abort = 1;
+            init->rc = -1;
+        }
+        pthread_cond_broadcast(&init->cond);
+    }
+    pthread_mutex_unlock(&init->lock);
+
+    return NULL;
+}
+
+static int
+init_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, int ordered_count,
+        uint32_t threads, int fatal_fail)
+{
+    struct srpd_init_s init = {.lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER};
+    pthread_t *tids = NULL;
+    uint32_t i, started = 0;
+    int r;
+
+    if ((threads < 2) || (plugin_count < 2)) {
+        /* sequential initialization in the sorted order */
+        for (i = 0; i < (uint32_t)plugin_count; ++i) {
+            if (init_plugin(sess, &plugins[i]) && fatal_fail) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (threads > (uint32_t)plugin_count) {
+        threads = plugin_count;
+    }
+
+    init.conn = sr_session_get_connection(sess);
+    init.plugins = plugins;
+    init.plugin_count = plugin_count;
+    init.ordered_count = ordered_count;
+    init.remaining = plugin_count;
+    init.fatal_fail = fatal_fail;
+    init.state = calloc(plugin_count, sizeof *init.state);
+    tids = malloc(threads * sizeof *tids);
+    if (!init.state || !tids) {
+        error_print(0, "Memory allocation failed.");
+        init.rc = -1;
+        goto cleanup;
+    }
+
+    /* initialize independent plugins in parallel */
+    for (started = 0; started < threads; ++started) {
+        if ((r = pthread_create(&tids[started], NULL, init_plugins_thread, &init))) {
+            SRPLG_LOG_ERR("sysrepo-plugind", "Failed to create a thread (%s).", strerror(r));
+            pthread_mutex_lock(&init.lock);
+            init.abort = 1;
+            init.rc = -1;
+            pthread_cond_broadcast(&init.cond);
+            pthread_mutex_unlock(&init.lock);
+            break;
+        }
+    }
+    for (i = 0; i < started; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+
+cleanup:
+    free(init.state);
+    free(tids);
+    pthread_mutex_destroy(&init.lock);
+    pthread_cond_destroy(&init.cond);
+    return init.rc;
+}
+
 static int
 publish_loaded_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count)
 {
     int rc = SR_ERR_OK, i;
-    char *xpath;
+    char *xpath, buf[21];
 
     /* switch to operational */
     sr_session_switch_ds(sess, SR_DS_OPERATIONAL);
@@ -403,6 +636,19 @@ publish_loaded_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, in
             if (rc) {
                 goto cleanup;
             }
+
+            /* add its initialization time */
+            if (asprintf(&xpath, "/sysrepo-plugind:sysrepo-plugind/loaded-plugins/plugin-init-time[plugin='%s']/time",
+                    plugins[i].plugin_name) == -1) {
+                rc = SR_ERR_NO_MEMORY;
+                goto cleanup;
+            }
+            sprintf(buf, "%" PRIu64, plugins[i].init_time);
+            rc = sr_set_item_str(sess, xpath, buf, NULL, 0);
+            free(xpath);
+            if (rc) {
+                goto cleanup;
+            }
         }
     }
 
@@ -471,7 +717,8 @@ main(int argc, char **argv)
     sr_conn_ctx_t *conn = NULL;
     sr_session_ctx_t *sess = NULL;
     sr_log_level_t log_level = SR_LL_ERR;
-    int plugin_count = 0, i, r, rc = EXIT_FAILURE, opt, debug = 0, pidfd = -1, fatal_fail = 0;
+    int plugin_count = 0, ordered_count = 0, i, r, rc = EXIT_FAILURE, opt, debug = 0, pidfd = -1, fatal_fail = 0;
+    uint32_t init_threads;
     const char *plugins_dir, *pidfile = NULL;
 
     struct option options[] = {
@@ -576,24 +823,18 @@ main(int argc, char **argv)
     }
 
     /* sort plugins based on user-defined order */
-    if ((r = srpd_sort_plugins(sess, plugins, plugin_count, "sysrepo-plugind"))) {
+    if ((r = srpd_sort_plugins(sess, plugins, plugin_count, "sysrepo-plugind", &ordered_count))) {
         error_print(r, "Sorting of plugins failed.");
         goto cleanup;
     }
 
     /* init plugins */
-    for (i = 0; i < plugin_count; ++i) {
-        r = plugins[i].init_cb(sess, &plugins[i].private_data);
-        if (r) {
-            SRPLG_LOG_ERR("sysrepo-plugind", "Plugin \"%s\" initialization failed (%s).", plugins[i].plugin_name,
-                    sr_strerror(r));
-            if (fatal_fail) {
-                goto cleanup;
-            }
-        } else {
-            SRPLG_LOG_INF("sysrepo-plugind", "Plugin \"%s\" initialized.", plugins[i].plugin_name);
-            plugins[i].initialized = 1;
-        }
+    if ((r = get_init_threads(sess, &init_threads))) {
+        error_print(r, "Getting plugin initialization threads failed.");
+        goto cleanup;
+    }
+    if (init_plugins(sess, plugins, plugin_count, ordered_count, init_threads, fatal_fail)) {
+        goto cleanup;
     }
 
     /* set state data */
@@ -631,7 +872,7 @@ cleanup:
     for (i = 0; i < plugin_count; ++i) {
         /* plugin cleanup */
         if (plugins[i].initialized) {
-            plugins[i].cleanup_cb(sess, plugins[i].private_data);
+            plugins[i].cleanup_cb(plugins[i].sess, plugins[i].private_data);
         }
 
         if (plugins[i].handle) {
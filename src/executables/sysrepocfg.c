@@ -20,11 +20,13 @@
 
 #include <errno.h>
 #include <getopt.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -38,6 +40,43 @@
 
 sr_log_level_t log_level = SR_LL_ERR;
 
+/** default number of backup/restore worker sessions */
+#define SRCFG_DEFAULT_JOBS 4
+
+/** name of the backup manifest file */
+#define SRCFG_BACKUP_MANIFEST "manifest"
+
+/** first line of the backup manifest */
+#define SRCFG_BACKUP_MANIFEST_HDR "sysrepocfg-backup 1"
+
+/**
+ * @brief Backup/restore of the data of a single module in a single datastore.
+ */
+struct backup_job {
+    sr_datastore_t ds;
+    char *module;
+    char *revision;
+    char *file;     /**< file with the data relative to the backup directory, NULL if there are none */
+    struct lyd_node *data;  /**< loaded data of the module, used by restore */
+};
+
+/**
+ * @brief Shared state of backup/restore worker threads.
+ */
+struct backup_pool {
+    pthread_mutex_t lock;
+    sr_conn_ctx_t *conn;
+    const char *dir_path;
+    struct backup_job *jobs;
+    uint32_t job_count;
+    uint32_t next_job;      /**< index of the next job to process, protected by lock */
+    int failed;             /**< set if any job failed, protected by lock */
+    int not_strict;
+    int timeout_s;
+
+    int (*job_cb)(sr_session_ctx_t *sess, struct backup_pool *pool, struct backup_job *job);
+};
+
 static void
 version_print(void)
 {
@@ -72,6 +111,9 @@ help_print(void)
             "                               parameter is used.\n"
             "  -G, --get <xpath>            Get the value of a node on the XPath. It is written to STDOUT unless '--value'\n"
             "                               parameter is used.\n"
+            "  -B, --backup <dir>           Store a consistent snapshot of running and startup datastores into a directory,\n"
+            "                               LYB data of every module and a manifest.\n"
+            "  -T, --restore <dir>          Restore running and startup datastores from a directory created by backup op.\n"
             "\n"
             "       When both a <path> and <editor>/<source-datastore> can be specified, it is always first checked\n"
             "       that the file exists. If not, then it is interpreted as the other parameter.\n"
@@ -93,8 +135,14 @@ help_print(void)
             "  -p, --depth <depth>          Limit the depth of returned subtrees, 0 (unlimited) by default. Accepted by\n"
             "                               export op.\n"
             "  -s, --no-subs                Do not request pull operational data (export op).\n"
+            "  -j, --jobs <count>           Number of worker sessions processing modules in parallel, 4 by\n"
+            "                               default. Accepted by backup, restore op.\n"
             "  -t, --timeout <seconds>      Set the timeout for the operation, otherwise the default one is used.\n"
             "                               Accepted by all op.\n"
+            "  -w, --stream                 Process the data module by module instead of all at once to limit the memory\n"
+            "                               required for very large datastores. Imported data are applied per module, not\n"
+            "                               atomically, and exported data cannot use the \"lyb\" format. Accepted by import,\n"
+            "                               export op without --module and --xpath.\n"
             "  -e, --defaults <wd-mode>     Print the default values, which are trimmed by default (\"report-all\",\n"
             "                               \"report-all-tagged\", \"trim\", \"explicit\", \"implicit-tagged\").\n"
             "                               Accepted by export, edit, rpc op.\n"
@@ -319,14 +367,181 @@ step_create_input_file(LYD_FORMAT format, char *tmp_file)
     return EXIT_SUCCESS;
 }
 
+static int
+step_module_has_data(const struct lys_module *mod, int config_only)
+{
+    const struct lysc_node *node = NULL;
+
+    if (!mod->implemented || !mod->compiled) {
+        return 0;
+    }
+
+    while ((node = lys_getnext(node, NULL, mod->compiled, 0))) {
+        if (!config_only || (node->flags & LYS_CONFIG_W)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+step_import_stream_batch(sr_session_ctx_t *sess, struct lyd_node *batch, struct ly_set *replaced, int timeout_s)
+{
+    const struct lys_module *mod = lyd_owner_module(batch);
+    int r;
+
+    if (ly_set_contains(replaced, mod, NULL)) {
+        /* another part of the data of this module, merge it to the already replaced data */
+        r = sr_edit_batch(sess, batch, "merge");
+        lyd_free_siblings(batch);
+        if (r) {
+            error_sr_print(sess);
+            error_print(r, "Failed to prepare edit");
+            return EXIT_FAILURE;
+        }
+
+        r = sr_apply_changes(sess, timeout_s * 1000);
+        if (r) {
+            error_sr_print(sess);
+            error_print(r, "Failed to merge edit data");
+            return EXIT_FAILURE;
+        }
+    } else {
+        /* replace config of the module (always spends data) */
+        r = sr_replace_config(sess, mod->name, batch, timeout_s * 1000);
+        if (r) {
+            error_sr_print(sess);
+            error_print(r, "Replace config failed");
+            return EXIT_FAILURE;
+        }
+
+        if (ly_set_add(replaced, (void *)mod, 1, NULL)) {
+            error_print(0, "Memory allocation failed");
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int
+op_import_stream(sr_session_ctx_t *sess, const char *file_path, LYD_FORMAT format, int not_strict, int timeout_s)
+{
+    const struct ly_ctx *ly_ctx;
+    const struct lys_module *mod;
+    struct ly_in *in = NULL;
+    struct ly_set *replaced = NULL;
+    struct lyd_node *subtree, *batch = NULL;
+    char *ptr;
+    uint32_t idx = 0;
+    int parse_flags, r, rc = EXIT_SUCCESS;
+    LY_ERR lyrc;
+
+    ly_ctx = sr_acquire_context(sr_session_get_connection(sess));
+
+    /* get input, a file is mapped and not read into memory */
+    if (file_path) {
+        lyrc = ly_in_new_filepath(file_path, 0, &in);
+        if (lyrc == LY_EINVAL) {
+            /* empty file */
+            ptr = strdup("");
+            ly_in_new_memory(ptr, &in);
+        } else if (lyrc) {
+            error_print(0, "Failed to create input handler from file \"%s\"", file_path);
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+    } else {
+        if (step_read_file(stdin, &ptr)) {
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+        ly_in_new_memory(ptr, &in);
+    }
+
+    if (ly_set_new(&replaced)) {
+        error_print(0, "Memory allocation failed");
+        rc = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    parse_flags = LYD_PARSE_NO_STATE | LYD_PARSE_ONLY | LYD_PARSE_STORE_ONLY | LYD_PARSE_SUBTREE |
+            (not_strict ? 0 : LYD_PARSE_STRICT);
+    do {
+        /* parse the next top-level subtree, LY_ENOT is returned if there are more of them */
+        subtree = NULL;
+        lyrc = lyd_parse_data(ly_ctx, NULL, in, format, parse_flags, 0, &subtree);
+        if (lyrc && (lyrc != LY_ENOT)) {
+            error_ly_print(ly_ctx);
+            error_print(0, "Data parsing failed");
+            lyd_free_siblings(subtree);
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+        if (!subtree) {
+            continue;
+        }
+
+        if (batch && (lyd_owner_module(batch) != lyd_owner_module(subtree))) {
+            /* data of another module, apply the previous one */
+            r = step_import_stream_batch(sess, batch, replaced, timeout_s);
+            batch = NULL;
+            if (r) {
+                lyd_free_siblings(subtree);
+                rc = EXIT_FAILURE;
+                goto cleanup;
+            }
+        }
+
+        /* collect consecutive subtrees of a single module */
+        lyd_insert_sibling(batch, subtree, &batch);
+    } while (lyrc == LY_ENOT);
+
+    if (batch) {
+        r = step_import_stream_batch(sess, batch, replaced, timeout_s);
+        batch = NULL;
+        if (r) {
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+    }
+
+    /* modules with no imported data have their config emptied, same as a full replace */
+    while ((mod = ly_ctx_get_module_iter(ly_ctx, &idx))) {
+        if (!step_module_has_data(mod, 1) || ly_set_contains(replaced, mod, NULL)) {
+            continue;
+        }
+
+        r = sr_replace_config(sess, mod->name, NULL, timeout_s * 1000);
+        if (r) {
+            error_sr_print(sess);
+            error_print(r, "Replace config failed");
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    lyd_free_siblings(batch);
+    ly_set_free(replaced, NULL);
+    ly_in_free(in, 1);
+    sr_release_context(sr_session_get_connection(sess));
+    return rc;
+}
+
 static int
 op_import(sr_session_ctx_t *sess, const char *file_path, const char *module_name, LYD_FORMAT format, int not_strict,
-        int timeout_s)
+        int stream, int timeout_s)
 {
     const struct ly_ctx *ly_ctx;
     struct lyd_node *data;
     int r, rc = EXIT_SUCCESS;
 
+    if (stream && !module_name) {
+        return op_import_stream(sess, file_path, format, not_strict, timeout_s);
+    }
+
     ly_ctx = sr_acquire_context(sr_session_get_connection(sess));
 
     if (step_load_data(ly_ctx, file_path, format, DATA_CONFIG, not_strict, 0, &data)) {
@@ -348,9 +563,102 @@ cleanup:
     return rc;
 }
 
+static int
+step_export_stream_print(FILE *file, const struct lyd_node *tree, LYD_FORMAT format, int wd_opt, int *printed)
+{
+    char *str, *start, *end;
+
+    if (format == LYD_XML) {
+        /* XML top-level siblings can simply be concatenated */
+        lyd_print_file(file, tree, format, LYD_PRINT_WITHSIBLINGS | wd_opt);
+        *printed = 1;
+        return EXIT_SUCCESS;
+    }
+
+    /* JSON, print only the members of the top-level object so that they can be joined */
+    if (lyd_print_mem(&str, tree, format, LYD_PRINT_WITHSIBLINGS | wd_opt)) {
+        error_print(0, "Failed to print data");
+        return EXIT_FAILURE;
+    }
+    start = str ? strchr(str, '{') : NULL;
+    end = str ? strrchr(str, '}') : NULL;
+    if (start && end && (end > start + 1)) {
+        /* skip the opening and closing new lines */
+        ++start;
+        if (start[0] == '\n') {
+            ++start;
+        }
+        if ((end > start) && (end[-1] == '\n')) {
+            --end;
+        }
+
+        if (end > start) {
+            fprintf(file, "%s%.*s", *printed ? ",\n" : "{\n", (int)(end - start), start);
+            *printed = 1;
+        }
+    }
+    free(str);
+
+    return EXIT_SUCCESS;
+}
+
+static int
+op_export_stream(sr_session_ctx_t *sess, FILE *file, LYD_FORMAT format, uint32_t max_depth, sr_get_options_t opts,
+        int wd_opt, int timeout_s)
+{
+    const struct ly_ctx *ly_ctx;
+    const struct lys_module *mod;
+    sr_data_t *data;
+    char *str;
+    uint32_t idx = 0;
+    int r, printed = 0, rc = EXIT_SUCCESS;
+
+    ly_ctx = sr_acquire_context(sr_session_get_connection(sess));
+
+    while ((mod = ly_ctx_get_module_iter(ly_ctx, &idx))) {
+        if (!step_module_has_data(mod, sr_session_get_ds(sess) != SR_DS_OPERATIONAL)) {
+            continue;
+        }
+
+        /* get data of a single module */
+        if (asprintf(&str, "/%s:*", mod->name) == -1) {
+            r = SR_ERR_NO_MEMORY;
+        } else {
+            r = sr_get_data(sess, str, max_depth, timeout_s * 1000, opts, &data);
+            free(str);
+        }
+        if (r != SR_ERR_OK) {
+            error_sr_print(sess);
+            error_print(r, "Getting data failed");
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+        if (!data) {
+            continue;
+        }
+
+        /* print it right away and free it */
+        r = step_export_stream_print(file, data->tree, format, wd_opt, &printed);
+        sr_release_data(data);
+        if (r) {
+            rc = EXIT_FAILURE;
+            goto cleanup;
+        }
+        fflush(file);
+    }
+
+    if (format == LYD_JSON) {
+        fprintf(file, printed ? "\n}\n" : "{\n}\n");
+    }
+
+cleanup:
+    sr_release_context(sr_session_get_connection(sess));
+    return rc;
+}
+
 static int
 op_export(sr_session_ctx_t *sess, const char *file_path, const char *module_name, const char *xpath, LYD_FORMAT format,
-        uint32_t max_depth, int no_subs, int wd_opt, int timeout_s)
+        uint32_t max_depth, int no_subs, int stream, int wd_opt, int timeout_s)
 {
     sr_data_t *data;
     FILE *file = NULL;
@@ -370,6 +678,15 @@ op_export(sr_session_ctx_t *sess, const char *file_path, const char *module_name
         }
     }
 
+    if (stream && !module_name && !xpath) {
+        /* get and print the data module by module */
+        r = op_export_stream(sess, file ? file : stdout, format, max_depth, opts, wd_opt, timeout_s);
+        if (file) {
+            fclose(file);
+        }
+        return r;
+    }
+
     /* get subtrees */
     if (module_name) {
         if (asprintf(&str, "/%s:*", module_name) == -1) {
@@ -403,6 +720,493 @@ op_export(sr_session_ctx_t *sess, const char *file_path, const char *module_name
     return EXIT_SUCCESS;
 }
 
+static const char *
+backup_ds2str(sr_datastore_t ds)
+{
+    return (ds == SR_DS_STARTUP) ? "startup" : "running";
+}
+
+static int
+backup_str2ds(const char *str, sr_datastore_t *ds)
+{
+    if (!strcmp(str, "running")) {
+        *ds = SR_DS_RUNNING;
+    } else if (!strcmp(str, "startup")) {
+        *ds = SR_DS_STARTUP;
+    } else {
+        error_print(0, "Unknown backup datastore \"%s\"", str);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static void
+backup_jobs_free(struct backup_job *jobs, uint32_t job_count)
+{
+    uint32_t i;
+
+    for (i = 0; i < job_count; ++i) {
+        free(jobs[i].module);
+        free(jobs[i].revision);
+        free(jobs[i].file);
+        lyd_free_siblings(jobs[i].data);
+    }
+    free(jobs);
+}
+
+static void *
+backup_worker_thread(void *arg)
+{
+    struct backup_pool *pool = arg;
+    sr_session_ctx_t *sess;
+    uint32_t idx;
+    int r;
+
+    if ((r = sr_session_start(pool->conn, SR_DS_RUNNING, &sess))) {
+        error_print(r, "Failed to start a session");
+        pthread_mutex_lock(&pool->lock);
+        pool->failed = 1;
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+
+    while (1) {
+        /* get the next job */
+        pthread_mutex_lock(&pool->lock);
+        if (pool->failed || (pool->next_job == pool->job_count)) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        idx = pool->next_job++;
+        pthread_mutex_unlock(&pool->lock);
+
+        sr_session_switch_ds(sess, pool->jobs[idx].ds);
+        if (pool->job_cb(sess, pool, &pool->jobs[idx])) {
+            pthread_mutex_lock(&pool->lock);
+            pool->failed = 1;
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+    }
+
+    sr_session_stop(sess);
+    return NULL;
+}
+
+static int
+backup_run_jobs(struct backup_pool *pool, uint32_t thread_count)
+{
+    pthread_t *threads;
+    uint32_t i, started;
+    int r;
+
+    if (thread_count > pool->job_count) {
+        thread_count = pool->job_count;
+    }
+    if (!thread_count) {
+        return EXIT_SUCCESS;
+    }
+
+    threads = malloc(thread_count * sizeof *threads);
+    if (!threads) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+
+    for (started = 0; started < thread_count; ++started) {
+        if ((r = pthread_create(&threads[started], NULL, backup_worker_thread, pool))) {
+            error_print(0, "Failed to create a thread (%s)", strerror(r));
+            pthread_mutex_lock(&pool->lock);
+            pool->failed = 1;
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+    }
+    for (i = 0; i < started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    return pool->failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static int
+backup_job_store(sr_session_ctx_t *sess, struct backup_pool *pool, struct backup_job *job)
+{
+    sr_data_t *data;
+    char *str;
+    int r;
+
+    /* get the module data */
+    if (asprintf(&str, "/%s:*", job->module) == -1) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    r = sr_get_data(sess, str, 0, pool->timeout_s * 1000, 0, &data);
+    free(str);
+    if (r) {
+        error_sr_print(sess);
+        error_print(r, "Getting data of \"%s\" failed", job->module);
+        return EXIT_FAILURE;
+    }
+
+    if (!data) {
+        /* no data, nothing to store */
+        return EXIT_SUCCESS;
+    }
+
+    /* store them */
+    if (asprintf(&job->file, "%s.%s.lyb", job->module, backup_ds2str(job->ds)) == -1) {
+        job->file = NULL;
+        sr_release_data(data);
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    if (asprintf(&str, "%s/%s", pool->dir_path, job->file) == -1) {
+        sr_release_data(data);
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    r = lyd_print_path(str, data->tree, LYD_LYB, LYD_PRINT_WITHSIBLINGS);
+    sr_release_data(data);
+    if (r) {
+        error_print(0, "Failed to write \"%s\"", str);
+        free(str);
+        return EXIT_FAILURE;
+    }
+    free(str);
+
+    return EXIT_SUCCESS;
+}
+
+static int
+backup_manifest_write(const char *dir_path, const struct backup_job *jobs, uint32_t job_count)
+{
+    FILE *file;
+    char *path;
+    uint32_t i;
+
+    if (asprintf(&path, "%s/%s", dir_path, SRCFG_BACKUP_MANIFEST) == -1) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    file = fopen(path, "w");
+    if (!file) {
+        error_print(0, "Failed to open \"%s\" for writing (%s)", path, strerror(errno));
+        free(path);
+        return EXIT_FAILURE;
+    }
+    free(path);
+
+    /* <datastore> <module> <revision> <file> */
+    fprintf(file, "%s\n", SRCFG_BACKUP_MANIFEST_HDR);
+    for (i = 0; i < job_count; ++i) {
+        fprintf(file, "%s %s %s %s\n", backup_ds2str(jobs[i].ds), jobs[i].module,
+                jobs[i].revision ? jobs[i].revision : "-", jobs[i].file ? jobs[i].file : "-");
+    }
+
+    if (fclose(file)) {
+        error_print(0, "Failed to write the backup manifest (%s)", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int
+op_backup(sr_session_ctx_t *sess, const char *dir_path, uint32_t thread_count, int timeout_s)
+{
+    const sr_datastore_t ds_list[] = {SR_DS_RUNNING, SR_DS_STARTUP};
+    sr_conn_ctx_t *conn = sr_session_get_connection(sess);
+    const struct ly_ctx *ly_ctx;
+    const struct lys_module *mod;
+    struct backup_pool pool = {.lock = PTHREAD_MUTEX_INITIALIZER};
+    struct backup_job *jobs = NULL, *job;
+    char *path;
+    uint32_t i, idx, locked = 0, job_count = 0;
+    int r, rc = EXIT_FAILURE;
+
+    if (mkdir(dir_path, 00755) && (errno != EEXIST)) {
+        error_print(0, "Failed to create directory \"%s\" (%s)", dir_path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    /* remove any previous manifest so that a failed backup cannot look complete */
+    if (asprintf(&path, "%s/%s", dir_path, SRCFG_BACKUP_MANIFEST) == -1) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    if (unlink(path) && (errno != ENOENT)) {
+        error_print(0, "Failed to remove \"%s\" (%s)", path, strerror(errno));
+        free(path);
+        return EXIT_FAILURE;
+    }
+    free(path);
+
+    ly_ctx = sr_acquire_context(conn);
+
+    /* a job for each module with configuration in each datastore */
+    for (i = 0; i < sizeof ds_list / sizeof *ds_list; ++i) {
+        idx = 0;
+        while ((mod = ly_ctx_get_module_iter(ly_ctx, &idx))) {
+            if (!step_module_has_data(mod, 1)) {
+                continue;
+            }
+
+            job = realloc(jobs, (job_count + 1) * sizeof *jobs);
+            if (!job) {
+                error_print(0, "Memory allocation failed");
+                goto cleanup;
+            }
+            jobs = job;
+            job = &jobs[job_count++];
+            memset(job, 0, sizeof *job);
+            job->ds = ds_list[i];
+            job->module = strdup(mod->name);
+            job->revision = mod->revision ? strdup(mod->revision) : NULL;
+            if (!job->module || (mod->revision && !job->revision)) {
+                error_print(0, "Memory allocation failed");
+                goto cleanup;
+            }
+        }
+    }
+
+    /* lock all the datastores so that no changes can be made while the snapshot is being read, reading is allowed */
+    for (locked = 0; locked < sizeof ds_list / sizeof *ds_list; ++locked) {
+        sr_session_switch_ds(sess, ds_list[locked]);
+        if ((r = sr_lock(sess, NULL, timeout_s * 1000))) {
+            error_sr_print(sess);
+            error_print(r, "Locking %s datastore failed", backup_ds2str(ds_list[locked]));
+            goto cleanup;
+        }
+    }
+
+    /* read the modules in parallel */
+    pool.conn = conn;
+    pool.dir_path = dir_path;
+    pool.jobs = jobs;
+    pool.job_count = job_count;
+    pool.timeout_s = timeout_s;
+    pool.job_cb = backup_job_store;
+    if (backup_run_jobs(&pool, thread_count)) {
+        goto cleanup;
+    }
+
+    /* written last so that there is no manifest for an incomplete backup */
+    if (backup_manifest_write(dir_path, jobs, job_count)) {
+        goto cleanup;
+    }
+
+    rc = EXIT_SUCCESS;
+
+cleanup:
+    while (locked) {
+        --locked;
+        sr_session_switch_ds(sess, ds_list[locked]);
+        if ((r = sr_unlock(sess, NULL))) {
+            error_sr_print(sess);
+            error_print(r, "Unlock failed");
+        }
+    }
+    sr_release_context(conn);
+    backup_jobs_free(jobs, job_count);
+    pthread_mutex_destroy(&pool.lock);
+    return rc;
+}
+
+static int
+backup_job_load(sr_session_ctx_t *sess, struct backup_pool *pool, struct backup_job *job)
+{
+    const struct ly_ctx *ly_ctx;
+    char *path;
+    int r, rc = EXIT_SUCCESS;
+
+    (void)sess;
+
+    if (!job->file) {
+        /* no data */
+        return EXIT_SUCCESS;
+    }
+
+    ly_ctx = sr_acquire_context(pool->conn);
+
+    /* load the module data */
+    if (asprintf(&path, "%s/%s", pool->dir_path, job->file) == -1) {
+        error_print(0, "Memory allocation failed");
+        rc = EXIT_FAILURE;
+        goto cleanup;
+    }
+    r = step_load_data(ly_ctx, path, LYD_LYB, DATA_CONFIG, pool->not_strict, 0, &job->data);
+    free(path);
+    if (r) {
+        rc = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+cleanup:
+    sr_release_context(pool->conn);
+    return rc;
+}
+
+static int
+backup_manifest_read(const char *dir_path, struct backup_job **jobs, uint32_t *job_count)
+{
+    FILE *file;
+    char *path, *line = NULL, *ds_str, *mod_str, *rev_str, *file_str, *saveptr;
+    size_t line_size = 0;
+    ssize_t len;
+    struct backup_job *job;
+    int rc = EXIT_FAILURE;
+
+    *jobs = NULL;
+    *job_count = 0;
+
+    if (asprintf(&path, "%s/%s", dir_path, SRCFG_BACKUP_MANIFEST) == -1) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    file = fopen(path, "r");
+    if (!file) {
+        error_print(0, "Failed to open \"%s\" for reading (%s)", path, strerror(errno));
+        free(path);
+        return EXIT_FAILURE;
+    }
+    free(path);
+
+    /* header */
+    len = getline(&line, &line_size, file);
+    if ((len > 0) && (line[len - 1] == '\n')) {
+        line[len - 1] = '\0';
+    }
+    if ((len < 1) || strcmp(line, SRCFG_BACKUP_MANIFEST_HDR)) {
+        error_print(0, "Invalid backup manifest in \"%s\"", dir_path);
+        goto cleanup;
+    }
+
+    while ((len = getline(&line, &line_size, file)) > 0) {
+        /* <datastore> <module> <revision> <file> */
+        ds_str = strtok_r(line, " \n", &saveptr);
+        mod_str = strtok_r(NULL, " \n", &saveptr);
+        rev_str = strtok_r(NULL, " \n", &saveptr);
+        file_str = strtok_r(NULL, " \n", &saveptr);
+        if (!ds_str) {
+            /* empty line */
+            continue;
+        } else if (!file_str) {
+            error_print(0, "Invalid backup manifest line \"%s\"", ds_str);
+            goto cleanup;
+        }
+
+        job = realloc(*jobs, (*job_count + 1) * sizeof **jobs);
+        if (!job) {
+            error_print(0, "Memory allocation failed");
+            goto cleanup;
+        }
+        *jobs = job;
+        job = &(*jobs)[(*job_count)++];
+        memset(job, 0, sizeof *job);
+
+        if (backup_str2ds(ds_str, &job->ds)) {
+            goto cleanup;
+        }
+        job->module = strdup(mod_str);
+        job->revision = strcmp(rev_str, "-") ? strdup(rev_str) : NULL;
+        job->file = strcmp(file_str, "-") ? strdup(file_str) : NULL;
+        if (!job->module) {
+            error_print(0, "Memory allocation failed");
+            goto cleanup;
+        }
+    }
+
+    rc = EXIT_SUCCESS;
+
+cleanup:
+    free(line);
+    fclose(file);
+    if (rc) {
+        backup_jobs_free(*jobs, *job_count);
+        *jobs = NULL;
+        *job_count = 0;
+    }
+    return rc;
+}
+
+static int
+op_restore(sr_session_ctx_t *sess, const char *dir_path, uint32_t thread_count, int not_strict, int timeout_s)
+{
+    const sr_datastore_t ds_list[] = {SR_DS_STARTUP, SR_DS_RUNNING};
+    sr_conn_ctx_t *conn = sr_session_get_connection(sess);
+    const struct ly_ctx *ly_ctx;
+    const struct lys_module *mod;
+    struct backup_pool pool = {.lock = PTHREAD_MUTEX_INITIALIZER};
+    struct backup_job *jobs;
+    struct lyd_node *data;
+    uint32_t i, j, job_count;
+    int r, rc = EXIT_FAILURE;
+
+    if (backup_manifest_read(dir_path, &jobs, &job_count)) {
+        return EXIT_FAILURE;
+    }
+
+    ly_ctx = sr_acquire_context(conn);
+
+    /* check all the modules before changing anything */
+    for (i = 0; i < job_count; ++i) {
+        mod = ly_ctx_get_module_implemented(ly_ctx, jobs[i].module);
+        if (!mod) {
+            error_print(0, "Module \"%s\" from the backup is not implemented", jobs[i].module);
+            goto cleanup;
+        }
+        if ((jobs[i].revision || mod->revision) &&
+                (!jobs[i].revision || !mod->revision || strcmp(jobs[i].revision, mod->revision))) {
+            error_print(0, "Module \"%s\" revision \"%s\" differs from the backup revision \"%s\"", jobs[i].module,
+                    mod->revision ? mod->revision : "none", jobs[i].revision ? jobs[i].revision : "none");
+            goto cleanup;
+        }
+    }
+
+    /* load the data of the modules in parallel */
+    pool.conn = conn;
+    pool.dir_path = dir_path;
+    pool.jobs = jobs;
+    pool.job_count = job_count;
+    pool.not_strict = not_strict;
+    pool.timeout_s = timeout_s;
+    pool.job_cb = backup_job_load;
+    if (backup_run_jobs(&pool, thread_count)) {
+        goto cleanup;
+    }
+
+    /* replace each datastore at once so that the data of all the modules are validated together */
+    for (i = 0; i < sizeof ds_list / sizeof *ds_list; ++i) {
+        data = NULL;
+        for (j = 0; j < job_count; ++j) {
+            if ((jobs[j].ds != ds_list[i]) || !jobs[j].data) {
+                continue;
+            }
+
+            lyd_insert_sibling(data, jobs[j].data, &data);
+            jobs[j].data = NULL;
+        }
+
+        /* always spends data */
+        sr_session_switch_ds(sess, ds_list[i]);
+        if ((r = sr_replace_config(sess, NULL, data, timeout_s * 1000))) {
+            error_sr_print(sess);
+            error_print(r, "Replace config of %s datastore failed", backup_ds2str(ds_list[i]));
+            goto cleanup;
+        }
+    }
+
+    rc = EXIT_SUCCESS;
+
+cleanup:
+    sr_release_context(conn);
+    backup_jobs_free(jobs, job_count);
+    pthread_mutex_destroy(&pool.lock);
+    return rc;
+}
+
 static int
 op_edit(sr_session_ctx_t *sess, const char *file_path, const char *editor, const char *module_name, LYD_FORMAT format,
         int lock, int not_strict, int opaq, int wd_opt, int timeout_s)
@@ -459,7 +1263,7 @@ op_edit(sr_session_ctx_t *sess, const char *file_path, const char *editor, const
     }
 
     /* use export operation to get data to edit */
-    if (op_export(sess, tmp_file, module_name, NULL, format, 0, 1, wd_opt, timeout_s)) {
+    if (op_export(sess, tmp_file, module_name, NULL, format, 0, 1, 0, wd_opt, timeout_s)) {
         goto cleanup_unlock;
     }
 
@@ -469,7 +1273,7 @@ op_edit(sr_session_ctx_t *sess, const char *file_path, const char *editor, const
     }
 
     /* use import operation to store edited data */
-    if (op_import(sess, tmp_file, module_name, format, not_strict, timeout_s)) {
+    if (op_import(sess, tmp_file, module_name, format, not_strict, 0, timeout_s)) {
         goto cleanup_unlock;
     }
 
@@ -765,7 +1569,8 @@ main(int argc, char **argv)
     char *ptr;
     int r, rc = EXIT_FAILURE, opt, operation = 0, lock = 0, not_strict = 0, opaq = 0, timeout = 0, wd_opt = 0;
     uint32_t max_depth = 0;
-    int no_subs = 0;
+    int no_subs = 0, stream = 0;
+    uint32_t jobs = SRCFG_DEFAULT_JOBS;
 
     struct option options[] = {
         {"help",            no_argument,       NULL, 'h'},
@@ -778,6 +1583,8 @@ main(int argc, char **argv)
         {"copy-from",       required_argument, NULL, 'C'},
         {"set",             required_argument, NULL, 'S'},
         {"get",             required_argument, NULL, 'G'},
+        {"backup",          required_argument, NULL, 'B'},
+        {"restore",         required_argument, NULL, 'T'},
         {"datastore",       required_argument, NULL, 'd'},
         {"module",          required_argument, NULL, 'm'},
         {"xpath",           required_argument, NULL, 'x'},
@@ -787,6 +1594,8 @@ main(int argc, char **argv)
         {"opaque",          no_argument,       NULL, 'o'},
         {"depth",           required_argument, NULL, 'p'},
         {"no-subs",         no_argument,       NULL, 's'},
+        {"stream",          no_argument,       NULL, 'w'},
+        {"jobs",            required_argument, NULL, 'j'},
         {"timeout",         required_argument, NULL, 't'},
         {"defaults",        required_argument, NULL, 'e'},
         {"value",           required_argument, NULL, 'u'},
@@ -801,7 +1610,7 @@ main(int argc, char **argv)
 
     /* process options */
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hVI::X::E::R::N::C:S:G:d:m:x:f:lnop:st:e:u:v:", options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVI::X::E::R::N::C:S:G:B:T:d:m:x:f:lnop:swj:t:e:u:v:", options, NULL)) != -1) {
         /* parameters with optional arguments */
         switch (opt) {
         case 'I':
@@ -921,6 +1730,15 @@ main(int argc, char **argv)
             xpath = optarg;
             operation = opt;
             break;
+        case 'B':
+        case 'T':
+            if (operation) {
+                error_print(0, "Operation already specified");
+                goto cleanup;
+            }
+            file_path = optarg;
+            operation = opt;
+            break;
         case 'd':
             if (arg_get_ds(optarg, &ds)) {
                 goto cleanup;
@@ -977,6 +1795,16 @@ main(int argc, char **argv)
         case 's':
             no_subs = 1;
             break;
+        case 'w':
+            stream = 1;
+            break;
+        case 'j':
+            jobs = strtoul(optarg, &ptr, 10);
+            if (ptr[0] || !jobs) {
+                error_print(0, "Invalid job count \"%s\"", optarg);
+                goto cleanup;
+            }
+            break;
         case 't':
             timeout = strtoul(optarg, &ptr, 10);
             if (ptr[0]) {
@@ -1078,14 +1906,18 @@ main(int argc, char **argv)
     if (format == LYD_UNKNOWN) {
         format = learn_lyd_format(file_path);
     }
+    if (stream && (operation == 'X') && (format == LYD_LYB)) {
+        error_print(0, "Streaming export does not support LYB format");
+        goto cleanup;
+    }
 
     /* perform the operation */
     switch (operation) {
     case 'I':
-        rc = op_import(sess, file_path, module_name, format, not_strict, timeout);
+        rc = op_import(sess, file_path, module_name, format, not_strict, stream, timeout);
         break;
     case 'X':
-        rc = op_export(sess, file_path, module_name, xpath, format, max_depth, no_subs, wd_opt, timeout);
+        rc = op_export(sess, file_path, module_name, xpath, format, max_depth, no_subs, stream, wd_opt, timeout);
         break;
     case 'E':
         rc = op_edit(sess, file_path, editor, module_name, format, lock, not_strict, opaq, wd_opt, timeout);
@@ -1105,6 +1937,12 @@ main(int argc, char **argv)
     case 'G':
         rc = op_get(sess, xpath, value, timeout);
         break;
+    case 'B':
+        rc = op_backup(sess, file_path, jobs, timeout);
+        break;
+    case 'T':
+        rc = op_restore(sess, file_path, jobs, not_strict, timeout);
+        break;
     case 0:
         error_print(0, "No operation specified");
         break;
@@ -915,14 +915,14 @@ cleanup:
 }
 
 sr_error_info_t *
-sr_lyd_new_implicit_tree(struct lyd_node *tree, uint32_t options)
+sr_lyd_new_implicit_tree(struct lyd_node *tree, uint32_t options, struct lyd_node **diff)
 {
     sr_error_info_t *err_info = NULL;
     uint32_t temp_lo = LY_LOSTORE;
 
     ly_temp_log_options(&temp_lo);
 
-    if (lyd_new_implicit_tree(tree, options, NULL)) {
+    if (lyd_new_implicit_tree(tree, options, diff)) {
         sr_errinfo_new_ly(&err_info, tree ? LYD_CTX(tree) : NULL, NULL, SR_ERR_LY);
         goto cleanup;
     }
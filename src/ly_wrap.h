@@ -404,9 +404,10 @@ sr_error_info_t *sr_lyd_new_implicit_module(struct lyd_node **data, const struct
  *
  * @param[in] tree Data tree to add to.
  * @param[in] options New implicit options.
+ * @param[out] diff Optional diff with any created nodes.
  * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_lyd_new_implicit_tree(struct lyd_node *tree, uint32_t options);
+sr_error_info_t *sr_lyd_new_implicit_tree(struct lyd_node *tree, uint32_t options, struct lyd_node **diff);
 
 /**
  * @brief Duplicate data node(s).
@@ -202,6 +202,8 @@ static int
 sr_modinfo_session_has_data_changes(sr_session_ctx_t *session, const struct lys_module *ly_mod)
 {
     const struct lyd_node *root;
+    char *top_name;
+    uint32_t i;
 
     assert(session);
 
@@ -219,6 +221,12 @@ sr_modinfo_session_has_data_changes(sr_session_ctx_t *session, const struct lys_
                 return 1;
             }
         }
+        for (i = 0; !sr_ev_data_get(session->ev_data.diff_lazy, i, NULL, (void **)&top_name); ++i) {
+            /* not yet parsed diff subtrees */
+            if (!strncmp(top_name, ly_mod->name, strlen(ly_mod->name)) && (top_name[strlen(ly_mod->name)] == ':')) {
+                return 1;
+            }
+        }
         if (session->ev != SR_SUB_EV_UPDATE) {
             break;
         }
@@ -318,6 +326,62 @@ cleanup:
     return err_info;
 }
 
+sr_error_info_t *
+sr_modinfo_collect_path(const struct ly_ctx *ly_ctx, const char *path, sr_session_ctx_t *session,
+        struct sr_mod_info_s *mod_info, int *simple)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lys_module *ly_mod;
+    const struct lysc_node *snode, *iter;
+    struct sr_mod_info_mod_s *mod;
+    const char *mod_name;
+    int mod_len, valid;
+
+    *simple = 0;
+
+    if (!sr_xpath_is_simple_path(path, &mod_name, &mod_len)) {
+        return NULL;
+    }
+
+    ly_mod = ly_ctx_get_module_implemented2(ly_ctx, mod_name, mod_len);
+    if (!ly_mod || !strcmp(ly_mod->name, "sysrepo") || !strcmp(ly_mod->name, "ietf-netconf")) {
+        /* let the XPath processing handle these */
+        return NULL;
+    }
+
+    /* resolve the path in the schema, if invalid let the XPath processing generate the error */
+    if ((err_info = sr_lys_find_path(ly_ctx, path, &valid, &snode)) || !valid) {
+        return err_info;
+    }
+
+    for (iter = snode; iter; iter = iter->parent) {
+        if ((iter->nodetype & (LYS_LIST | LYS_LEAFLIST)) && (iter->flags & LYS_CONFIG_R)) {
+            /* state (leaf-)list instances may be duplicated so more nodes can match, let the XPath processing
+             * find all of them */
+            return NULL;
+        }
+    }
+
+    *simple = 1;
+    if (sr_modinfo_session_has_data_changes(session, ly_mod)) {
+        /* the session changes are applied on the whole module data */
+        return sr_modinfo_add(ly_mod, NULL, 0, 0, mod_info);
+    }
+
+    if ((err_info = sr_modinfo_add(ly_mod, path, 0, 0, mod_info))) {
+        return err_info;
+    }
+
+    mod = &mod_info->mods[mod_info->mod_count - 1];
+    if ((mod->ly_mod == ly_mod) && (mod->xpath_count == 1) && ((path[strlen(path) - 1] == ']') ||
+            !(snode->nodetype & (LYS_LIST | LYS_LEAFLIST)))) {
+        /* only a single subtree is selected */
+        mod->state |= MOD_INFO_PATH;
+    }
+
+    return NULL;
+}
+
 sr_error_info_t *
 sr_modinfo_collect_oper_sess(sr_session_ctx_t *sess, const struct lys_module *ly_mod, struct sr_mod_info_s *mod_info)
 {
@@ -710,6 +774,154 @@ sr_modinfo_diff_merge(struct sr_mod_info_s *mod_info, const struct lyd_node *new
     return NULL;
 }
 
+/**
+ * @brief Get the current ID of module running data, the same one used for the connection running data cache.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] ly_mod Module of the data.
+ * @param[in] shm_mod SHM module of the data.
+ * @param[out] data_id Running data ID.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_run_data_id(sr_conn_ctx_t *conn, const struct lys_module *ly_mod, sr_mod_t *shm_mod, uint32_t *data_id)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct sr_ds_handle_s *ds_handle;
+    sr_datastore_t ds;
+
+    if (!shm_mod->plugins[SR_DS_RUNNING]) {
+        /* disabled running, use startup */
+        ds = SR_DS_STARTUP;
+    } else {
+        ds = SR_DS_RUNNING;
+    }
+
+    if ((err_info = sr_ds_handle_find(conn->mod_shm.addr + shm_mod->plugins[ds], conn, &ds_handle))) {
+        return err_info;
+    }
+
+    if (ds_handle->plugin->data_version_cb) {
+        return ds_handle->plugin->data_version_cb(ly_mod, ds, ds_handle->plg_data, data_id);
+    }
+
+    *data_id = shm_mod->run_cache_id;
+    return NULL;
+}
+
+/**
+ * @brief Get a digest of module data.
+ *
+ * @param[in] mod_data Module data, only the data of a single module.
+ * @param[out] digest Data digest.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_module_data_digest(const struct lyd_node *mod_data, uint64_t digest[2])
+{
+    sr_error_info_t *err_info = NULL;
+    char *str = NULL;
+    uint32_t len = 0;
+
+    if (mod_data && (err_info = sr_lyd_print_data(mod_data, LYD_JSON, LYD_PRINT_SHRINK | LYD_PRINT_WD_EXPLICIT, -1,
+            &str, &len))) {
+        return err_info;
+    }
+
+    sr_mem_digest(str, len, digest);
+    free(str);
+    return NULL;
+}
+
+sr_error_info_t *
+sr_modinfo_replace_digest(struct sr_mod_info_s *mod_info, struct lyd_node **src_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_mod_s *mod;
+    struct lyd_node *src_mod_data;
+    uint32_t i;
+
+    assert(mod_info->ds == SR_DS_RUNNING);
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        assert((mod->state & MOD_INFO_NEW) && !mod->xpath_count);
+
+        /* digest only the data of this module */
+        src_mod_data = sr_module_data_unlink(src_data, mod->ly_mod, 0);
+        err_info = sr_modinfo_module_data_digest(src_mod_data, mod->replace_digest);
+        if (src_mod_data) {
+            lyd_insert_sibling(*src_data, src_mod_data, src_data);
+        }
+        if (err_info) {
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Check whether the current running data of a module were stored by a replace with the same source data.
+ * The module must be at least READ_UPGR-locked.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod Mod info module with the digest of the new source data.
+ * @param[out] unchanged Whether the data would not change by the replace.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_replace_is_unchanged(sr_conn_ctx_t *conn, const struct sr_mod_info_mod_s *mod, int *unchanged)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t data_id;
+
+    *unchanged = 0;
+
+    if ((!mod->replace_digest[0] && !mod->replace_digest[1]) ||
+            memcmp(mod->replace_digest, mod->shm_mod->run_replaced_digest, sizeof mod->replace_digest)) {
+        /* different source data */
+        return NULL;
+    }
+
+    /* the data must not have been modified since */
+    if ((err_info = sr_modinfo_run_data_id(conn, mod->ly_mod, mod->shm_mod, &data_id))) {
+        return err_info;
+    }
+    *unchanged = (data_id == mod->shm_mod->run_replaced_id);
+    return NULL;
+}
+
+/**
+ * @brief Remember the digest of the replace source data of a module in mod SHM. The module must be at least
+ * READ_UPGR-locked and its data must have already been stored.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod Mod info module with the digest of the source data.
+ */
+static void
+sr_modinfo_replace_digest_store(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t data_id;
+
+    if ((mod->state & MOD_INFO_UPDATED) || (!mod->replace_digest[0] && !mod->replace_digest[1])) {
+        /* not a replace or the stored data differ from the source data */
+        memset(mod->shm_mod->run_replaced_digest, 0, sizeof mod->shm_mod->run_replaced_digest);
+        return;
+    }
+
+    /* the data ID of the stored data is stored with the digest */
+    if ((err_info = sr_modinfo_run_data_id(conn, mod->ly_mod, mod->shm_mod, &data_id))) {
+        /* only an optimization */
+        sr_errinfo_free(&err_info);
+        memset(mod->shm_mod->run_replaced_digest, 0, sizeof mod->shm_mod->run_replaced_digest);
+        return;
+    }
+    mod->shm_mod->run_replaced_id = data_id;
+    memcpy(mod->shm_mod->run_replaced_digest, mod->replace_digest, sizeof mod->replace_digest);
+}
+
 sr_error_info_t *
 sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data)
 {
@@ -755,6 +967,12 @@ sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data)
                 lyd_insert_sibling(mod_info->data, dst_mod_data, &mod_info->data);
             }
             lyd_free_all(src_mod_data);
+
+            if ((mod_info->ds == SR_DS_RUNNING) && (mod->state & MOD_INFO_RLOCK_UPGR) &&
+                    (mod->replace_digest[0] || mod->replace_digest[1])) {
+                /* the current data are the result of this replace */
+                sr_modinfo_replace_digest_store(mod_info->conn, mod);
+            }
         }
     }
 
@@ -1143,7 +1361,7 @@ sr_xpath_oper_data_get(struct sr_mod_info_mod_s *mod, const char *xpath, const c
 
     if (*oper_data) {
         /* add any missing NP containers, redundant to add top-level containers */
-        if ((err_info = sr_lyd_new_implicit_tree(*oper_data, LYD_IMPLICIT_NO_DEFAULTS))) {
+        if ((err_info = sr_lyd_new_implicit_tree(*oper_data, LYD_IMPLICIT_NO_DEFAULTS, NULL))) {
             goto cleanup;
         }
     }
@@ -1736,13 +1954,21 @@ static sr_error_info_t *
 sr_modinfo_module_data_load_yanglib(struct sr_mod_info_s *mod_info, struct sr_mod_info_mod_s *mod)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *mod_data;
+    struct lyd_node *mod_data = NULL;
     uint32_t content_id, i;
     struct ly_set *set = NULL;
 
     /* get content-id */
     content_id = SR_CONN_MAIN_SHM(mod_info->conn)->content_id;
 
+    /* try to use the data generated for the same context before */
+    if ((err_info = sr_conn_yanglib_cache_get(mod_info->conn, content_id, &mod_data))) {
+        goto cleanup;
+    }
+    if (mod_data) {
+        goto merge;
+    }
+
     /* get the data from libyang */
     if ((err_info = sr_ly_ctx_get_yanglib_data(mod_info->conn->ly_ctx, &mod_data, content_id))) {
         goto cleanup;
@@ -1798,13 +2024,19 @@ sr_modinfo_module_data_load_yanglib(struct sr_mod_info_s *mod_info, struct sr_mo
         }
     }
 
-    /* connect to the rest of data */
-    if ((err_info = sr_lyd_merge(&mod_info->data, mod_data, 1, LYD_MERGE_DESTRUCT))) {
+    /* cache the finished data */
+    if ((err_info = sr_conn_yanglib_cache_update(mod_info->conn, content_id, mod_data))) {
         goto cleanup;
     }
 
+merge:
+    /* connect to the rest of data */
+    err_info = sr_lyd_merge(&mod_info->data, mod_data, 1, LYD_MERGE_DESTRUCT);
+    mod_data = NULL;
+
 cleanup:
     ly_set_free(set, NULL);
+    lyd_free_siblings(mod_data);
     return err_info;
 }
 
@@ -1992,38 +2224,29 @@ cleanup:
 }
 
 /**
- * @brief Append a "subscriptions" data node with the specific subscriptions to sysrepo-monitoring module data.
+ * @brief Append "change-sub" data nodes to sysrepo-monitoring module subscriptions.
  *
  * @param[in] conn Connection to use.
  * @param[in] shm_mod SHM module to read from.
- * @param[in,out] sr_mod Module list node of sysrepo-monitoring.
+ * @param[in,out] sr_subs Subscriptions container node of sysrepo-monitoring.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_modinfo_module_srmon_module_subs(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_mod)
+sr_modinfo_module_srmon_change_subs(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_subs)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *sr_subs, *sr_xpath_sub, *sr_sub;
+    struct lyd_node *sr_sub;
     sr_datastore_t ds;
     sr_mod_change_sub_t *change_subs;
-    sr_mod_oper_get_sub_t *oper_get_subs;
-    sr_mod_oper_get_xpath_sub_t *xpath_sub;
-    sr_mod_oper_poll_sub_t *oper_poll_subs;
-    sr_mod_notif_sub_t *notif_subs;
-    uint32_t i, j;
+    uint32_t i;
     char buf[128];
 
-    /* subscriptions, make implicit */
-    if ((err_info = sr_lyd_new_inner(sr_mod, NULL, "subscriptions", &sr_subs))) {
-        return err_info;
-    }
-    sr_subs->flags |= LYD_DEFAULT;
-
-    /*
-     * change subscriptions
-     */
-
     for (ds = 0; ds < SR_DS_COUNT; ++ds) {
+        if (!shm_mod->change_sub[ds].sub_count) {
+            /* no subscriptions, do not lock */
+            continue;
+        }
+
         /* CHANGE SUB READ LOCK */
         if ((err_info = sr_rwlock(&shm_mod->change_sub[ds].lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
                 __func__, NULL, NULL))) {
@@ -2091,9 +2314,31 @@ change_sub_unlock:
         }
     }
 
-    /*
-     * oper get subscriptions
-     */
+    return NULL;
+}
+
+/**
+ * @brief Append "operational-get-sub" data nodes to sysrepo-monitoring module subscriptions.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] shm_mod SHM module to read from.
+ * @param[in,out] sr_subs Subscriptions container node of sysrepo-monitoring.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_module_srmon_oper_get_subs(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_subs)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *sr_xpath_sub, *sr_sub;
+    sr_mod_oper_get_sub_t *oper_get_subs;
+    sr_mod_oper_get_xpath_sub_t *xpath_sub;
+    uint32_t i, j;
+    char buf[128];
+
+    if (!shm_mod->oper_get_sub_count) {
+        /* no subscriptions, do not lock */
+        return NULL;
+    }
 
     /* OPER GET SUB READ LOCK */
     if ((err_info = sr_rwlock(&shm_mod->oper_get_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
@@ -2148,13 +2393,30 @@ operget_sub_unlock:
     /* OPER GET SUB READ UNLOCK */
     sr_rwunlock(&shm_mod->oper_get_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
-    if (err_info) {
-        return err_info;
-    }
+    return err_info;
+}
 
-    /*
-     * oper poll subscriptions
-     */
+/**
+ * @brief Append "operational-poll-sub" data nodes to sysrepo-monitoring module subscriptions.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] shm_mod SHM module to read from.
+ * @param[in,out] sr_subs Subscriptions container node of sysrepo-monitoring.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_module_srmon_oper_poll_subs(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_subs)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *sr_sub;
+    sr_mod_oper_poll_sub_t *oper_poll_subs;
+    uint32_t i;
+    char buf[128];
+
+    if (!shm_mod->oper_poll_sub_count) {
+        /* no subscriptions, do not lock */
+        return NULL;
+    }
 
     /* OPER POLL SUB READ LOCK */
     if ((err_info = sr_rwlock(&shm_mod->oper_poll_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
@@ -2201,13 +2463,30 @@ operpoll_sub_unlock:
     /* OPER POLL SUB READ UNLOCK */
     sr_rwunlock(&shm_mod->oper_poll_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
-    if (err_info) {
-        return err_info;
-    }
+    return err_info;
+}
 
-    /*
-     * notification subscriptions
-     */
+/**
+ * @brief Append "notification-sub" data nodes to sysrepo-monitoring module subscriptions.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] shm_mod SHM module to read from.
+ * @param[in,out] sr_subs Subscriptions container node of sysrepo-monitoring.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_module_srmon_notif_subs(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_subs)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *sr_sub;
+    sr_mod_notif_sub_t *notif_subs;
+    uint32_t i;
+    char buf[128];
+
+    if (!shm_mod->notif_sub_count) {
+        /* no subscriptions, do not lock */
+        return NULL;
+    }
 
     /* NOTIF SUB READ LOCK */
     if ((err_info = sr_rwlock(&shm_mod->notif_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid,
@@ -2256,19 +2535,42 @@ notif_sub_unlock:
     return err_info;
 }
 
+/**
+ * @brief Parts of a sysrepo-monitoring "module" data node that are generated separately.
+ */
+typedef enum {
+    SR_SRMON_MOD_DATASTORE = 0x0001,        /**< datastore */
+    SR_SRMON_MOD_DATA_LOCK = 0x0002,        /**< data-lock */
+    SR_SRMON_MOD_DS_LOCK = 0x0004,          /**< ds-lock */
+    SR_SRMON_MOD_CHANGE_SUB_LOCK = 0x0008,  /**< change-sub-lock */
+    SR_SRMON_MOD_OPER_GET_SUB_LOCK = 0x0010,    /**< oper-get-sub-lock */
+    SR_SRMON_MOD_OPER_POLL_SUB_LOCK = 0x0020,   /**< oper-poll-sub-lock */
+    SR_SRMON_MOD_NOTIF_SUB_LOCK = 0x0040,   /**< notif-sub-lock */
+    SR_SRMON_MOD_CHANGE_SUB = 0x0080,       /**< subscriptions/change-sub */
+    SR_SRMON_MOD_OPER_GET_SUB = 0x0100,     /**< subscriptions/operational-get-sub */
+    SR_SRMON_MOD_OPER_POLL_SUB = 0x0200,    /**< subscriptions/operational-poll-sub */
+    SR_SRMON_MOD_NOTIF_SUB = 0x0400         /**< subscriptions/notification-sub */
+} sr_srmon_mod_part_t;
+
+/** paths of ::sr_srmon_mod_part_t parts relative to the "module" node, in the same order */
+static const char *sr_srmon_mod_part_paths[] = {"datastore", "data-lock", "ds-lock", "change-sub-lock", "oper-get-sub-lock",
+    "oper-poll-sub-lock", "notif-sub-lock", "subscriptions/change-sub", "subscriptions/operational-get-sub",
+    "subscriptions/operational-poll-sub", "subscriptions/notification-sub"};
+
 /**
  * @brief Append a "module" data node with its subscriptions to sysrepo-monitoring data.
  *
  * @param[in] conn Connection to use.
  * @param[in] shm_mod SHM module to read from.
+ * @param[in] parts Bitmask of ::sr_srmon_mod_part_t parts to generate.
  * @param[in,out] sr_state Main container node of sysrepo-monitoring.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_modinfo_module_srmon_module(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct lyd_node *sr_state)
+sr_modinfo_module_srmon_module(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t parts, struct lyd_node *sr_state)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *sr_mod, *sr_ds_lock;
+    struct lyd_node *sr_mod, *sr_ds_lock, *sr_subs;
     sr_datastore_t ds;
     struct sr_mod_lock_s *shm_lock;
 
@@ -2281,7 +2583,7 @@ sr_modinfo_module_srmon_module(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct ly
     }
 
     /* last-modified */
-    for (ds = 0; ds < SR_DS_COUNT; ++ds) {
+    for (ds = 0; (parts & SR_SRMON_MOD_DATASTORE) && (ds < SR_DS_COUNT); ++ds) {
         if ((ds == SR_DS_RUNNING) && !shm_mod->plugins[ds]) {
             /* runnig disabled */
             continue;
@@ -2292,15 +2594,19 @@ sr_modinfo_module_srmon_module(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, struct ly
         }
     }
 
-    for (ds = 0; ds < SR_DS_COUNT; ++ds) {
+    for (ds = 0; (parts & (SR_SRMON_MOD_DATA_LOCK | SR_SRMON_MOD_DS_LOCK)) && (ds < SR_DS_COUNT); ++ds) {
         shm_lock = &shm_mod->data_lock_info[ds];
 
         /* data-lock */
-        snprintf(buf, BUF_LEN, "data-lock[cid='%%" PRIu32 "'][datastore='%s'][mode='%%s']", sr_ds2ident(ds));
-        err_info = sr_modinfo_module_srmon_locks_ds(&shm_lock->data_lock, conn->cid, buf, sr_mod);
+        if (parts & SR_SRMON_MOD_DATA_LOCK) {
+            snprintf(buf, BUF_LEN, "data-lock[cid='%%" PRIu32 "'][datastore='%s'][mode='%%s']", sr_ds2ident(ds));
+            if ((err_info = sr_modinfo_module_srmon_locks_ds(&shm_lock->data_lock, conn->cid, buf, sr_mod))) {
+                return err_info;
+            }
+        }
 
-        if (err_info) {
-            return err_info;
+        if (!(parts & SR_SRMON_MOD_DS_LOCK)) {
+            continue;
         }
 
         /* DS LOCK */
@@ -2342,7 +2648,7 @@ ds_unlock:
     }
 
     /* change-sub-lock */
-    for (ds = 0; ds < SR_DS_COUNT; ++ds) {
+    for (ds = 0; (parts & SR_SRMON_MOD_CHANGE_SUB_LOCK) && (ds < SR_DS_COUNT); ++ds) {
         snprintf(buf, BUF_LEN, "change-sub-lock[cid='%%" PRIu32 "'][datastore='%s'][mode='%%s']", sr_ds2ident(ds));
         if ((err_info = sr_modinfo_module_srmon_locks_ds(&shm_mod->change_sub[ds].lock, 0, buf, sr_mod))) {
             return err_info;
@@ -2351,22 +2657,47 @@ ds_unlock:
 #undef BUF_LEN
 
     /* oper-get-sub-lock */
-    if ((err_info = sr_modinfo_module_srmon_locks(&shm_mod->oper_get_lock, "oper-get-sub-lock", sr_mod))) {
+    if ((parts & SR_SRMON_MOD_OPER_GET_SUB_LOCK) &&
+            (err_info = sr_modinfo_module_srmon_locks(&shm_mod->oper_get_lock, "oper-get-sub-lock", sr_mod))) {
         return err_info;
     }
 
     /* oper-poll-sub-lock */
-    if ((err_info = sr_modinfo_module_srmon_locks(&shm_mod->oper_poll_lock, "oper-poll-sub-lock", sr_mod))) {
+    if ((parts & SR_SRMON_MOD_OPER_POLL_SUB_LOCK) &&
+            (err_info = sr_modinfo_module_srmon_locks(&shm_mod->oper_poll_lock, "oper-poll-sub-lock", sr_mod))) {
         return err_info;
     }
 
     /* notif-sub-lock */
-    if ((err_info = sr_modinfo_module_srmon_locks(&shm_mod->notif_lock, "notif-sub-lock", sr_mod))) {
+    if ((parts & SR_SRMON_MOD_NOTIF_SUB_LOCK) &&
+            (err_info = sr_modinfo_module_srmon_locks(&shm_mod->notif_lock, "notif-sub-lock", sr_mod))) {
         return err_info;
     }
 
+    if (!(parts & (SR_SRMON_MOD_CHANGE_SUB | SR_SRMON_MOD_OPER_GET_SUB | SR_SRMON_MOD_OPER_POLL_SUB |
+            SR_SRMON_MOD_NOTIF_SUB))) {
+        return NULL;
+    }
+
+    /* subscriptions, make implicit */
+    if ((err_info = sr_lyd_new_inner(sr_mod, NULL, "subscriptions", &sr_subs))) {
+        return err_info;
+    }
+    sr_subs->flags |= LYD_DEFAULT;
+
     /* module subscriptions */
-    if ((err_info = sr_modinfo_module_srmon_module_subs(conn, shm_mod, sr_mod))) {
+    if ((parts & SR_SRMON_MOD_CHANGE_SUB) && (err_info = sr_modinfo_module_srmon_change_subs(conn, shm_mod, sr_subs))) {
+        return err_info;
+    }
+    if ((parts & SR_SRMON_MOD_OPER_GET_SUB) &&
+            (err_info = sr_modinfo_module_srmon_oper_get_subs(conn, shm_mod, sr_subs))) {
+        return err_info;
+    }
+    if ((parts & SR_SRMON_MOD_OPER_POLL_SUB) &&
+            (err_info = sr_modinfo_module_srmon_oper_poll_subs(conn, shm_mod, sr_subs))) {
+        return err_info;
+    }
+    if ((parts & SR_SRMON_MOD_NOTIF_SUB) && (err_info = sr_modinfo_module_srmon_notif_subs(conn, shm_mod, sr_subs))) {
         return err_info;
     }
 
@@ -2569,7 +2900,7 @@ sr_modinfo_module_data_load_srmon(struct sr_mod_info_s *mod_info, struct sr_mod_
     sr_rpc_t *shm_rpc;
     const struct lys_module *ly_mod;
     sr_mod_shm_t *mod_shm;
-    uint32_t i, j;
+    uint32_t i, j, parts;
     int req;
 
     mod_shm = SR_CONN_MOD_SHM(mod_info->conn);
@@ -2586,6 +2917,18 @@ sr_modinfo_module_data_load_srmon(struct sr_mod_info_s *mod_info, struct sr_mod_
         goto cleanup;
     }
     if (req) {
+        /* learn which parts of the modules are required, generating some of them is costly */
+        parts = 0;
+        for (i = 0; i < sizeof sr_srmon_mod_part_paths / sizeof *sr_srmon_mod_part_paths; ++i) {
+            if ((err_info = sr_modinfo_module_data_oper_required(mod, &req, "/sysrepo-monitoring:sysrepo-state/module/%s",
+                    sr_srmon_mod_part_paths[i]))) {
+                goto cleanup;
+            }
+            if (req) {
+                parts |= (1 << i);
+            }
+        }
+
         for (i = 0; i < mod_shm->mod_count; ++i) {
             shm_mod = SR_SHM_MOD_IDX(mod_shm, i);
             if ((err_info = sr_modinfo_module_data_oper_required(mod, &req,
@@ -2593,7 +2936,7 @@ sr_modinfo_module_data_load_srmon(struct sr_mod_info_s *mod_info, struct sr_mod_
                 goto cleanup;
             }
 
-            if (req && (err_info = sr_modinfo_module_srmon_module(mod_info->conn, shm_mod, mod_data))) {
+            if (req && (err_info = sr_modinfo_module_srmon_module(mod_info->conn, shm_mod, parts, mod_data))) {
                 goto cleanup;
             }
         }
@@ -2639,6 +2982,66 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Duplicate cached running data selected by a simple path (see ::sr_xpath_is_simple_path()) with all
+ * their parents.
+ *
+ * @param[in] data Cached running data.
+ * @param[in] path Simple path selecting at most a single subtree.
+ * @param[in] with_ancestor Whether to duplicate the deepest existing ancestor (without descendants) if the selected
+ * node does not exist.
+ * @param[out] path_data Duplicated data, NULL if none.
+ * @param[out] resolved Whether @p path could be resolved directly, if not, @p path_data are not set.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_path_data_dup(const struct lyd_node *data, const char *path, int with_ancestor, struct lyd_node **path_data,
+        int *resolved)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *node = NULL;
+    uint32_t dup_opts = LYD_DUP_RECURSIVE | LYD_DUP_WITH_PARENTS | LYD_DUP_WITH_FLAGS;
+
+    *path_data = NULL;
+    *resolved = 0;
+
+    if (!data) {
+        /* no data */
+        *resolved = 1;
+        return NULL;
+    }
+
+    if ((err_info = sr_lyd_find_path(data, path, 0, &node))) {
+        /* cannot be resolved directly (such as missing list keys) */
+        sr_errinfo_free(&err_info);
+        return NULL;
+    }
+
+    if (!node && with_ancestor) {
+        /* find the deepest existing ancestor */
+        if ((err_info = sr_lyd_find_path(data, path, 1, &node))) {
+            return err_info;
+        }
+        dup_opts &= ~LYD_DUP_RECURSIVE;
+    }
+    *resolved = 1;
+
+    if (!node) {
+        return NULL;
+    }
+
+    if ((err_info = sr_lyd_dup(node, NULL, dup_opts, 0, path_data))) {
+        return err_info;
+    }
+
+    /* return the top-level node */
+    while (lyd_parent(*path_data)) {
+        *path_data = lyd_parent(*path_data);
+    }
+
+    return NULL;
+}
+
 /**
  * @brief Load module data of a specific module.
  *
@@ -2657,9 +3060,10 @@ sr_modinfo_module_data_load(struct sr_mod_info_s *mod_info, struct sr_mod_info_m
     sr_error_info_t *err_info = NULL;
     sr_conn_ctx_t *conn = mod_info->conn;
     struct lyd_node *mod_data = NULL;
+    struct lyd_node *path_data = NULL;
     const char **xpaths;
     uint32_t xpath_count;
-    int modified, has_data;
+    int modified, has_data, resolved = 0;
     char *orig_name = NULL;
     void *orig_data = NULL;
 
@@ -2709,13 +3113,32 @@ sr_modinfo_module_data_load(struct sr_mod_info_s *mod_info, struct sr_mod_info_m
             }
         /* fallthrough */
         case SR_DS_RUNNING:
-            /* copy all module data */
-            err_info = sr_lyd_get_module_data(&mod_info->conn->run_cache_data, mod->ly_mod, 0, 1, &mod_data);
+            if ((mod->state & MOD_INFO_PATH) && (mod->xpath_count == 1)) {
+                /* copy only the selected subtree */
+                err_info = sr_modinfo_path_data_dup(mod_info->conn->run_cache_data, mod->xpaths[0], 0, &mod_data,
+                        &resolved);
+            }
+            if (!err_info && !resolved) {
+                /* copy all module data */
+                err_info = sr_lyd_get_module_data(&mod_info->conn->run_cache_data, mod->ly_mod, 0, 1, &mod_data);
+            }
             break;
         case SR_DS_OPERATIONAL:
-            /* copy only enabled module data */
-            err_info = sr_module_oper_data_get_enabled(conn, &mod_info->conn->run_cache_data, mod, get_oper_opts,
-                    1, &mod_data);
+            if ((mod->state & MOD_INFO_PATH) && (mod->xpath_count == 1)) {
+                /* copy only the selected subtree, or its existing parents for the oper pull subscriptions */
+                err_info = sr_modinfo_path_data_dup(mod_info->conn->run_cache_data, mod->xpaths[0], 1, &path_data,
+                        &resolved);
+                if (!err_info && resolved) {
+                    /* keep only enabled data */
+                    err_info = sr_module_oper_data_get_enabled(conn, &path_data, mod, get_oper_opts, 0, &mod_data);
+                    lyd_free_siblings(path_data);
+                }
+            }
+            if (!err_info && !resolved) {
+                /* copy only enabled module data */
+                err_info = sr_module_oper_data_get_enabled(conn, &mod_info->conn->run_cache_data, mod, get_oper_opts,
+                        1, &mod_data);
+            }
             break;
         }
         if (err_info) {
@@ -3117,6 +3540,71 @@ cleanup:
     return err_info;
 }
 
+sr_error_info_t *
+sr_modinfo_replace_data_load(struct sr_mod_info_s *mod_info, sr_session_ctx_t *sess)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_s mod_info2;
+    struct sr_mod_info_mod_s *mod;
+    uint32_t i, j, unchanged_count = 0;
+    int unchanged;
+
+    assert(mod_info->ds == SR_DS_RUNNING);
+    SR_MODINFO_INIT(mod_info2, mod_info->conn, mod_info->ds, mod_info->ds);
+
+    /* learn which required modules would change, the modules are locked so their data cannot be modified */
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if (!(mod->state & MOD_INFO_REQ)) {
+            continue;
+        }
+
+        if ((err_info = sr_modinfo_replace_is_unchanged(mod_info->conn, mod, &unchanged))) {
+            goto cleanup;
+        }
+        if (unchanged) {
+            SR_LOG_DBG("Module \"%s\" data unchanged, skipping replace.", mod->ly_mod->name);
+            ++unchanged_count;
+        } else if ((err_info = sr_modinfo_add(mod->ly_mod, NULL, 0, 1, &mod_info2))) {
+            goto cleanup;
+        }
+    }
+
+    if (unchanged_count) {
+        /* collect the modules needed for the required modules that may change */
+        if ((err_info = sr_modinfo_consolidate(&mod_info2, SR_LOCK_NONE, SR_MI_INV_DEPS | SR_MI_DATA_NO | SR_MI_PERM_NO,
+                NULL, 0, 0, 0))) {
+            goto cleanup;
+        }
+
+        /* only these modules are used, keep the others locked but without data */
+        for (i = 0; i < mod_info->mod_count; ++i) {
+            mod = &mod_info->mods[i];
+            for (j = 0; j < mod_info2.mod_count; ++j) {
+                if (mod_info2.mods[j].ly_mod == mod->ly_mod) {
+                    break;
+                }
+            }
+
+            mod->state &= ~MOD_INFO_TYPE_MASK;
+            if (j < mod_info2.mod_count) {
+                mod->state |= mod_info2.mods[j].state & MOD_INFO_TYPE_MASK;
+            } else {
+                mod->state |= MOD_INFO_DEP | MOD_INFO_DATA;
+            }
+        }
+    }
+
+    /* load the data */
+    if ((err_info = sr_modinfo_data_load(mod_info, 0, sess, 0, 0))) {
+        goto cleanup;
+    }
+
+cleanup:
+    sr_modinfo_erase(&mod_info2);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_modinfo_validate(struct sr_mod_info_s *mod_info, uint32_t mod_state, int finish_diff, sr_error_info_t **val_err_info)
 {
@@ -3185,26 +3673,165 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Learn whether removing an instance of a schema node may cause a default node to be created instead.
+ *
+ * @param[in] schema Schema node of the removed node.
+ * @return Whether default nodes of the parent may need to be added.
+ */
+static int
+sr_modinfo_add_defaults_dflt_may_appear(const struct lysc_node *schema)
+{
+    if (schema->parent && (schema->parent->nodetype == LYS_CASE)) {
+        /* another (default) case may become active */
+        return 1;
+    }
+
+    switch (schema->nodetype) {
+    case LYS_LEAF:
+        return ((struct lysc_node_leaf *)schema)->dflt ? 1 : 0;
+    case LYS_LEAFLIST:
+        return ((struct lysc_node_leaflist *)schema)->dflts ? 1 : 0;
+    case LYS_CONTAINER:
+        return lysc_is_np_cont(schema) ? 1 : 0;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Collect data nodes whose descendants may be missing default nodes after a change.
+ *
+ * @param[in] diff_node Diff node of the change.
+ * @param[in] data_parent Data parent of the diff node, NULL if top-level.
+ * @param[in] data_first First data sibling of the diff node.
+ * @param[in,out] parents Set of data nodes to add default nodes into.
+ * @param[in,out] top_level Set if top-level default nodes need to be added.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_add_defaults_parents_r(const struct lyd_node *diff_node, struct lyd_node *data_parent,
+        const struct lyd_node *data_first, struct ly_set *parents, int *top_level)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *diff_child;
+    struct lyd_node *match = NULL;
+    int parent_dflts = 0;
+
+    if (!diff_node->schema) {
+        /* opaque node */
+        return NULL;
+    }
+
+    switch (sr_edit_diff_find_oper(diff_node, 1, NULL)) {
+    case EDIT_CREATE:
+        /* another case may have been removed and the default nodes of this one need to be added */
+        parent_dflts = diff_node->schema->parent && (diff_node->schema->parent->nodetype == LYS_CASE);
+
+        if (diff_node->schema->nodetype & LYD_NODE_INNER) {
+            /* the whole created subtree may be missing default nodes */
+            if ((err_info = sr_lyd_find_sibling_first(data_first, diff_node, &match))) {
+                return err_info;
+            }
+        }
+        break;
+    case EDIT_DELETE:
+        parent_dflts = sr_modinfo_add_defaults_dflt_may_appear(diff_node->schema);
+        break;
+    default:
+        if (!lyd_child_no_keys(diff_node)) {
+            break;
+        }
+
+        /* descend into the changed subtree */
+        if ((err_info = sr_lyd_find_sibling_first(data_first, diff_node, &match))) {
+            return err_info;
+        }
+        if (match) {
+            LY_LIST_FOR(lyd_child_no_keys(diff_node), diff_child) {
+                if ((err_info = sr_modinfo_add_defaults_parents_r(diff_child, match, lyd_child(match), parents,
+                        top_level))) {
+                    return err_info;
+                }
+            }
+        }
+        match = NULL;
+        break;
+    }
+
+    if (parent_dflts) {
+        if (!data_parent) {
+            *top_level = 1;
+        } else if (!ly_set_contains(parents, data_parent, NULL) && (err_info = sr_ly_set_add(parents, data_parent))) {
+            return err_info;
+        }
+    }
+    if (match && !ly_set_contains(parents, match, NULL) && (err_info = sr_ly_set_add(parents, match))) {
+        return err_info;
+    }
+
+    return NULL;
+}
+
 sr_error_info_t *
 sr_modinfo_add_defaults(struct sr_mod_info_s *mod_info, int finish_diff)
 {
     sr_error_info_t *err_info = NULL;
     struct sr_mod_info_mod_s *mod;
-    struct lyd_node *diff = NULL, *iter;
-    uint32_t i;
+    struct lyd_node *diff = NULL, *node_diff = NULL, *iter;
+    struct ly_set *parents = NULL;
+    uint32_t i, j;
+    int top_level;
 
     assert(!mod_info->data_cached && SR_IS_CONVENTIONAL_DS(mod_info->ds));
 
+    if ((err_info = sr_ly_set_new(&parents))) {
+        goto cleanup;
+    }
+
     for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
 
         if (mod->state & MOD_INFO_REQ) {
-            /* add default values for this module */
-            if ((err_info = sr_lyd_new_implicit_module(&mod_info->data, mod->ly_mod, LYD_IMPLICIT_NO_STATE,
-                    finish_diff ? &diff : NULL))) {
-                goto cleanup;
+            /* the stored data include all the default nodes so they can be missing only where the data were changed */
+            ly_set_clean(parents, NULL);
+            top_level = 0;
+            LY_LIST_FOR(mod_info->notify_diff, iter) {
+                if (lyd_owner_module(iter) != mod->ly_mod) {
+                    continue;
+                }
+
+                if ((err_info = sr_modinfo_add_defaults_parents_r(iter, NULL, mod_info->data, parents, &top_level))) {
+                    goto cleanup;
+                }
+            }
+
+            if (top_level) {
+                /* add default values for this module */
+                if ((err_info = sr_lyd_new_implicit_module(&mod_info->data, mod->ly_mod, LYD_IMPLICIT_NO_STATE,
+                        finish_diff ? &diff : NULL))) {
+                    goto cleanup;
+                }
+                mod_info->data = lyd_first_sibling(mod_info->data);
+            } else {
+                /* add default values only into the changed subtrees */
+                for (j = 0; j < parents->count; ++j) {
+                    if ((err_info = sr_lyd_new_implicit_tree(parents->dnodes[j], LYD_IMPLICIT_NO_STATE,
+                            finish_diff ? &node_diff : NULL))) {
+                        goto cleanup;
+                    }
+
+                    if (node_diff) {
+                        if ((err_info = sr_lyd_diff_merge_all(&diff, node_diff))) {
+                            goto cleanup;
+                        }
+                        lyd_free_all(node_diff);
+                        node_diff = NULL;
+                    }
+                }
             }
-            mod_info->data = lyd_first_sibling(mod_info->data);
 
             if (diff) {
                 /* it may not have been modified before */
@@ -3232,7 +3859,9 @@ sr_modinfo_add_defaults(struct sr_mod_info_s *mod_info, int finish_diff)
     }
 
 cleanup:
+    ly_set_free(parents, NULL);
     lyd_free_all(diff);
+    lyd_free_all(node_diff);
     return err_info;
 }
 
@@ -3374,9 +4003,15 @@ cleanup:
     return err_info;
 }
 
-sr_error_info_t *
-sr_modinfo_get_filter(struct sr_mod_info_s *mod_info, const char *xpath, sr_session_ctx_t *session,
-        struct ly_set **result)
+/**
+ * @brief Apply any session changes to data in mod info to get the session-specific data.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] session Sysrepo session.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_session_changes_apply(struct sr_mod_info_s *mod_info, sr_session_ctx_t *session)
 {
     sr_error_info_t *err_info = NULL, *val_err_info = NULL;
     struct sr_mod_info_mod_s *mod;
@@ -3389,6 +4024,9 @@ sr_modinfo_get_filter(struct sr_mod_info_s *mod_info, const char *xpath, sr_sess
         switch (session->ev) {
         case SR_SUB_EV_CHANGE:
         case SR_SUB_EV_UPDATE:
+            if ((err_info = sr_session_ev_diff_materialize(session))) {
+                goto cleanup;
+            }
             diff = session->dt[session->ds].diff;
             if (session->ev != SR_SUB_EV_UPDATE) {
                 break;
@@ -3443,19 +4081,54 @@ sr_modinfo_get_filter(struct sr_mod_info_s *mod_info, const char *xpath, sr_sess
         }
     }
 
-    if (mod_info->data) {
-        /* filter return data using the xpath */
-        if ((err_info = sr_lyd_find_xpath(mod_info->data, xpath, result))) {
-            goto cleanup;
-        }
-    } else {
-        /* empty set */
-        if ((err_info = sr_ly_set_new(result))) {
-            goto cleanup;
-        }
+cleanup:
+    return err_info;
+}
+
+sr_error_info_t *
+sr_modinfo_get_filter(struct sr_mod_info_s *mod_info, const char *xpath, sr_session_ctx_t *session,
+        struct ly_set **result)
+{
+    sr_error_info_t *err_info = NULL;
+
+    /* get the session-specific data */
+    if ((err_info = sr_modinfo_session_changes_apply(mod_info, session))) {
+        return err_info;
     }
 
-cleanup:
+    /* filter return data using the xpath, empty set if there are no data */
+    return sr_lyd_find_xpath(mod_info->data, xpath, result);
+}
+
+sr_error_info_t *
+sr_modinfo_get_path(struct sr_mod_info_s *mod_info, const char *path, sr_session_ctx_t *session,
+        struct ly_set **result)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *node = NULL;
+
+    /* get the session-specific data */
+    if ((err_info = sr_modinfo_session_changes_apply(mod_info, session))) {
+        return err_info;
+    }
+
+    /* find the node directly */
+    if (mod_info->data && (err_info = sr_lyd_find_path(mod_info->data, path, 0, &node))) {
+        /* cannot be resolved directly (such as missing list keys), evaluate it as an XPath on the same data */
+        sr_errinfo_free(&err_info);
+        return sr_lyd_find_xpath(mod_info->data, path, result);
+    } else if (node && (node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) && (path[strlen(path) - 1] != ']')) {
+        /* there may be more instances selected */
+        return sr_lyd_find_xpath(mod_info->data, path, result);
+    }
+
+    if ((err_info = sr_ly_set_new(result))) {
+        return err_info;
+    }
+    if (node && (err_info = sr_ly_set_add(*result, node))) {
+        ly_set_free(*result, NULL);
+        *result = NULL;
+    }
     return err_info;
 }
 
@@ -3504,6 +4177,28 @@ sr_modinfo_update_is_foreign(const struct sr_mod_info_s *mod_info, const struct
     return 0;
 }
 
+/**
+ * @brief Mark modules with data in an update edit as updated.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] update_edit Update edit.
+ */
+static void
+sr_modinfo_update_mark(struct sr_mod_info_s *mod_info, const struct lyd_node *update_edit)
+{
+    const struct lyd_node *node;
+    uint32_t i;
+
+    LY_LIST_FOR(update_edit, node) {
+        for (i = 0; i < mod_info->mod_count; ++i) {
+            if (mod_info->mods[i].ly_mod == lyd_owner_module(node)) {
+                mod_info->mods[i].state |= MOD_INFO_UPDATED;
+                break;
+            }
+        }
+    }
+}
+
 sr_error_info_t *
 sr_modinfo_change_notify_update(struct sr_mod_info_s *mod_info, sr_session_ctx_t *session, uint32_t timeout_ms,
         sr_lock_mode_t *change_sub_lock, sr_error_info_t **err_info2)
@@ -3562,6 +4257,9 @@ sr_modinfo_change_notify_update(struct sr_mod_info_s *mod_info, sr_session_ctx_t
             }
         }
 
+        /* mark the updated modules */
+        sr_modinfo_update_mark(mod_info, update_edit);
+
         /* backup the old diff */
         old_diff = mod_info->notify_diff;
         mod_info->notify_diff = NULL;
@@ -3636,6 +4334,7 @@ sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *mod_info, sr_sessi
     sr_error_info_t *err_info = NULL;
     struct lyd_node *root, *elem, *notif = NULL;
     struct ly_set *set;
+    sr_mod_shm_t *mod_shm;
     sr_mod_t *shm_mod;
     struct timespec notif_ts_mono, notif_ts_real;
     sr_mod_notif_sub_t *notif_subs;
@@ -3647,6 +4346,22 @@ sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *mod_info, sr_sessi
     int changes;
     LY_ERR lyrc;
 
+    if ((mod_info->ds == SR_DS_CANDIDATE) || (mod_info->ds == SR_DS_OPERATIONAL)) {
+        /* not supported */
+        return NULL;
+    }
+
+    /* get the module, its index is stored */
+    mod_shm = SR_CONN_MOD_SHM(mod_info->conn);
+    SR_CHECK_INT_RET(mod_shm->ncn_mod_idx >= mod_shm->mod_count, err_info);
+    shm_mod = SR_SHM_MOD_IDX(mod_shm, mod_shm->ncn_mod_idx);
+
+    /* check replay support and any subscriptions, even dead or suspended, without locking */
+    if (!shm_mod->replay_supp && !shm_mod->notif_sub_count) {
+        /* nothing to do */
+        return NULL;
+    }
+
     /* make sure there are some actual node changes */
     changes = 0;
     LY_LIST_FOR(mod_info->notify_diff, root) {
@@ -3667,32 +4382,25 @@ sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *mod_info, sr_sessi
         return NULL;
     }
 
-    if ((mod_info->ds == SR_DS_CANDIDATE) || (mod_info->ds == SR_DS_OPERATIONAL)) {
-        /* not supported */
-        return NULL;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(mod_info->conn, SR_LOCK_READ, 0, __func__))) {
-        return err_info;
-    }
-
-    /* get subscriber count */
-    err_info = sr_notif_find_subscriber(mod_info->conn, "ietf-netconf-notifications", &notif_subs, &notif_sub_count, NULL);
+    if (!shm_mod->replay_supp) {
+        /* EXT READ LOCK */
+        if ((err_info = sr_shmext_conn_remap_lock(mod_info->conn, SR_LOCK_READ, 0, __func__))) {
+            return err_info;
+        }
 
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(mod_info->conn, SR_LOCK_READ, 0, __func__);
+        /* get active subscriber count */
+        err_info = sr_notif_find_subscriber(mod_info->conn, "ietf-netconf-notifications", &notif_subs,
+                &notif_sub_count, NULL);
 
-    if (err_info) {
-        return err_info;
-    }
+        /* EXT READ UNLOCK */
+        sr_shmext_conn_remap_unlock(mod_info->conn, SR_LOCK_READ, 0, __func__);
 
-    /* get this module and check replay support */
-    shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(mod_info->conn), "ietf-netconf-notifications");
-    SR_CHECK_INT_RET(!shm_mod, err_info);
-    if (!shm_mod->replay_supp && !notif_sub_count) {
-        /* nothing to do */
-        return NULL;
+        if (err_info) {
+            return err_info;
+        } else if (!notif_sub_count) {
+            /* nothing to do */
+            return NULL;
+        }
     }
 
     lyrc = ly_set_new(&set);
@@ -3873,6 +4581,9 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info, sr_session_ctx_t *session,
                 /* update the cache ID because data were modified, ignored if data_version callback is used instead */
                 mod->shm_mod->run_cache_id++;
 
+                /* remember the source data digest if stored by a replace */
+                sr_modinfo_replace_digest_store(mod_info->conn, mod);
+
                 if (mod_info->conn->opts & SR_CONN_CACHE_RUNNING) {
                     /* store the changed data in the cache */
                     if ((err_info = sr_conn_run_cache_update_mod(mod_info->conn, mod->ly_mod, mod->shm_mod->run_cache_id,
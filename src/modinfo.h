@@ -38,6 +38,8 @@
 #define MOD_INFO_DATA       0x0100 /* module data were loaded */
 #define MOD_INFO_CHANGED    0x0200 /* module data were changed */
 #define MOD_INFO_XPATH_DYN  0x0400 /* module XPaths are dynamically allocated and need to be freed */
+#define MOD_INFO_UPDATED    0x0800 /* module data were modified by an "update" event */
+#define MOD_INFO_PATH       0x1000 /* the only module XPath is a simple path selecting a single subtree */
 
 /**
  * @brief Mod info structure, used for keeping all relevant modules for a data operation.
@@ -60,6 +62,7 @@ struct sr_mod_info_s {
         uint32_t state;         /**< Module state (flags). */
         uint32_t request_id;    /**< Request ID of the published event. */
         uint32_t reuse_diff;    /**< Whether a reusable diff has been written into the shm for this request_id. */
+        uint64_t replace_digest[2]; /**< Digest of the source data of a running replace, all zeros if not used. */
     } *mods;                    /**< Relevant modules. */
     uint32_t mod_count;         /**< Modules count. */
 };
@@ -118,6 +121,23 @@ sr_error_info_t *sr_modinfo_collect_edit(const struct lyd_node *edit, struct sr_
 sr_error_info_t *sr_modinfo_collect_xpath(const struct ly_ctx *ly_ctx, const char *xpath, sr_datastore_t ds,
         sr_session_ctx_t *session, uint32_t xpath_opts, struct sr_mod_info_s *mod_info);
 
+/**
+ * @brief Collect the required module for getting data selected by a simple path (see ::sr_xpath_is_simple_path())
+ * in mod info, resolving it only in the schema without compiling an XPath. The path is stored the same as for
+ * #MOD_INFO_XPATH_STORE_SESSION_CHANGES and if it selects a single subtree, only this subtree is copied from cached
+ * running data when loading the module data.
+ *
+ * @param[in] ly_ctx libyang context.
+ * @param[in] path Path to be resolved.
+ * @param[in] session Session to get the changes from.
+ * @param[in,out] mod_info Mod info to add to.
+ * @param[out] simple Whether @p path is simple, valid, can match only a single node, and the module was collected,
+ * otherwise ::sr_modinfo_collect_xpath() must be used.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_collect_path(const struct ly_ctx *ly_ctx, const char *path, sr_session_ctx_t *session,
+        struct sr_mod_info_s *mod_info, int *simple);
+
 /**
  * @brief Collect modules with oper push data of a session.
  *
@@ -200,6 +220,25 @@ sr_error_info_t *sr_modinfo_oper_ds_diff(struct sr_mod_info_s *mod_info, const s
  */
 sr_error_info_t *sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data);
 
+/**
+ * @brief Compute digests of the source data of all the modules in mod info for a running replace.
+ *
+ * @param[in] mod_info Mod info with new (not yet consolidated) modules to use.
+ * @param[in,out] src_data New data to be set, only their top-level order may be changed.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_replace_digest(struct sr_mod_info_s *mod_info, struct lyd_node **src_data);
+
+/**
+ * @brief Load data for a running replace. Required modules whose current data were stored by a replace with
+ * the same source data (digest) are not changed and their data are loaded only if needed by other modules.
+ *
+ * @param[in] mod_info Mod info consolidated with ::SR_MI_DATA_NO and READ_UPGR-locked.
+ * @param[in] sess Session to use.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_replace_data_load(struct sr_mod_info_s *mod_info, sr_session_ctx_t *sess);
+
 /**
  * @brief Generate oper notify diff for subscribers.
  *
@@ -312,6 +351,18 @@ sr_error_info_t *sr_modinfo_op_validate(struct sr_mod_info_s *mod_info, struct l
 sr_error_info_t *sr_modinfo_get_filter(struct sr_mod_info_s *mod_info, const char *xpath, sr_session_ctx_t *session,
         struct ly_set **result);
 
+/**
+ * @brief Find data selected by a simple path in mod info collected by ::sr_modinfo_collect_path().
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] path Simple path of the selected node.
+ * @param[in] session Sysrepo session.
+ * @param[out] result Resulting set with the matching node, if any.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_get_path(struct sr_mod_info_s *mod_info, const char *path, sr_session_ctx_t *session,
+        struct ly_set **result);
+
 /**
  * @brief Publish "update" event for diff in mod info and update it is needed.
  *
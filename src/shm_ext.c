@@ -69,7 +69,13 @@ sr_shmext_conn_remap_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int ext_lock
         if ((err_info = sr_file_get_size(conn->ext_shm.fd, &shm_file_size))) {
             goto error_ext_remap_unlock;
         }
-        if (shm_file_size != conn->ext_shm.size) {
+        if ((shm_file_size != conn->ext_shm.size) && (shm_file_size <= conn->ext_shm.map_size)) {
+            /* ext SHM size changed but the mapping covers it, readers do not use the size */
+            if (mode == SR_LOCK_READ_UPGR) {
+                /* only a single READ UPGR lock holder so it can be safely updated for a possible upgrade */
+                conn->ext_shm.size = shm_file_size;
+            }
+        } else if (shm_file_size != conn->ext_shm.size) {
             /* ext SHM size changed and we need to remap it */
             if (mode == SR_LOCK_READ_UPGR) {
                 /* REMAP WRITE LOCK UPGRADE */
@@ -943,6 +949,9 @@ sr_shmext_oper_get_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub_
         goto cleanup_unlock;
     }
 
+    /* cached schema-mount data may no longer be used */
+    sr_conn_ext_data_changed(conn, conn->mod_shm.addr + shm_mod->name);
+
 cleanup_unlock:
     /* EXT WRITE UNLOCK */
     sr_shmext_conn_remap_unlock(conn, SR_LOCK_WRITE, 1, __func__);
@@ -1002,6 +1011,9 @@ sr_shmext_oper_get_sub_free(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t del
         sr_shmext_print(SR_CONN_MOD_SHM(conn), &conn->ext_shm);
     }
 
+    /* cached schema-mount data may be used again */
+    sr_conn_ext_data_changed(conn, conn->mod_shm.addr + shm_mod->name);
+
 cleanup:
     return err_info;
 }
@@ -1733,319 +1745,6 @@ sr_shmext_rpc_sub_stop(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count,
     return err_info;
 }
 
-/**
- * @brief Recover all change subscriptions for a datastore.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_mod SHM mod with the subscriptions.
- * @param[in] ds Datastore to use.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_change(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, sr_datastore_t ds)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    uint32_t count;
-
-    /* CHANGE SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_mod->change_sub[ds].lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
-            __func__, NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (count = shm_mod->change_sub[ds].sub_count; count; --count) {
-        if ((tmp_err = sr_shmext_change_sub_stop(conn, shm_mod, ds, count - 1, 1, 1))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        }
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* CHANGE SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_mod->change_sub[ds].lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
-
-    return err_info;
-}
-
-/**
- * @brief Recover all oper get subscriptions.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_mod SHM mod with the subscriptions.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_oper_get(sr_conn_ctx_t *conn, sr_mod_t *shm_mod)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    sr_mod_oper_get_sub_t *shm_sub;
-    uint32_t i, count;
-
-    /* OPER GET SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_mod->oper_get_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid,
-            __func__, NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (i = 0; i < shm_mod->oper_get_sub_count; ++i) {
-        shm_sub = &((sr_mod_oper_get_sub_t *)(conn->ext_shm.addr + shm_mod->oper_get_subs))[i];
-
-        for (count = shm_sub->xpath_sub_count; count; --count) {
-            if ((tmp_err = sr_shmext_oper_get_sub_stop(conn, shm_mod, i, count - 1, 1, 1))) {
-                sr_errinfo_merge(&err_info, tmp_err);
-            }
-        }
-
-        /* operational get subscriptions change */
-        if ((tmp_err = sr_shmsub_oper_poll_get_sub_change_notify_evpipe(conn, conn->mod_shm.addr + shm_mod->name,
-                conn->ext_shm.addr + shm_sub->xpath))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        }
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* OPER GET SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_mod->oper_get_lock, 0, SR_LOCK_WRITE, conn->cid, __func__);
-
-    return err_info;
-}
-
-/**
- * @brief Recover all oper poll subscriptions.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_mod SHM mod with the subscriptions.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_oper_poll(sr_conn_ctx_t *conn, sr_mod_t *shm_mod)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    uint32_t count;
-
-    /* OPER POLL SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_mod->oper_poll_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
-            NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (count = shm_mod->oper_poll_sub_count; count; --count) {
-        if ((tmp_err = sr_shmext_oper_poll_sub_stop(conn, shm_mod, count - 1, 1, 1))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        }
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* OPER POLL SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_mod->oper_poll_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
-
-    return err_info;
-}
-
-/**
- * @brief Recover all notification subscriptions.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_mod SHM mod with the subscriptions.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_notif(sr_conn_ctx_t *conn, sr_mod_t *shm_mod)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    uint32_t count;
-
-    /* NOTIF SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_mod->notif_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
-            NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (count = shm_mod->notif_sub_count; count; --count) {
-        if ((tmp_err = sr_shmext_notif_sub_stop(conn, shm_mod, count - 1, 1, 1))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        }
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* NOTIF SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_mod->notif_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
-
-    return err_info;
-}
-
-/**
- * @brief Recover all extension RPC subscriptions.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_mod SHM mod with the subscriptions.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_rpc_ext(sr_conn_ctx_t *conn, sr_mod_t *shm_mod)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    sr_mod_rpc_sub_t *shm_subs;
-    uint32_t count;
-    char *path = NULL;
-
-    /* RPC SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_mod->rpc_ext_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
-            NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (count = shm_mod->rpc_ext_sub_count; count; --count) {
-        shm_subs = (sr_mod_rpc_sub_t *)(conn->ext_shm.addr + shm_mod->rpc_ext_subs);
-        if ((tmp_err = sr_get_trim_predicates(conn->ext_shm.addr + shm_subs[count - 1].xpath, &path))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        } else {
-            if ((tmp_err = sr_shmext_rpc_sub_stop(conn, &shm_mod->rpc_ext_subs,
-                    &shm_mod->rpc_ext_sub_count, path, count - 1, 1, 1))) {
-                sr_errinfo_merge(&err_info, tmp_err);
-            }
-        }
-        free(path);
-        path = NULL;
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* RPC SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_mod->rpc_ext_lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
-
-    return err_info;
-}
-
-/**
- * @brief Recover all RPC subscriptions.
- *
- * @param[in] conn Connection to use.
- * @param[in] shm_rpc SHM rpc with the subscriptions.
- * @return err_info, NULL on success.
- */
-static sr_error_info_t *
-sr_shmext_recover_sub_rpc(sr_conn_ctx_t *conn, sr_rpc_t *shm_rpc)
-{
-    sr_error_info_t *err_info = NULL, *tmp_err;
-    uint32_t count;
-
-    /* RPC SUB WRITE LOCK */
-    if ((err_info = sr_rwlock(&shm_rpc->lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
-            NULL, NULL))) {
-        return err_info;
-    }
-
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 1, __func__))) {
-        goto cleanup_unlock1;
-    }
-
-    for (count = shm_rpc->sub_count; count; --count) {
-        if ((tmp_err = sr_shmext_rpc_sub_stop(conn, &shm_rpc->subs, &shm_rpc->sub_count,
-                conn->mod_shm.addr + shm_rpc->path, count - 1, 1, 1))) {
-            sr_errinfo_merge(&err_info, tmp_err);
-        }
-    }
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
-
-cleanup_unlock1:
-    /* RPC SUB WRITE UNLOCK */
-    sr_rwunlock(&shm_rpc->lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
-
-    return err_info;
-}
-
-void
-sr_shmext_recover_sub_all(sr_conn_ctx_t *conn)
-{
-    sr_error_info_t *err_info = NULL;
-    sr_datastore_t ds;
-    sr_mod_t *shm_mod;
-    sr_rpc_t *shm_rpc;
-    uint32_t i, j;
-
-    /* go through all the modules, RPCs and recover their subscriptions */
-    for (i = 0; i < SR_CONN_MOD_SHM(conn)->mod_count; ++i) {
-        shm_mod = SR_SHM_MOD_IDX(conn->mod_shm.addr, i);
-
-        /* change subs */
-        for (ds = 0; ds < SR_DS_COUNT; ++ds) {
-            if ((err_info = sr_shmext_recover_sub_change(conn, shm_mod, ds))) {
-                sr_errinfo_free(&err_info);
-            }
-        }
-
-        /* oper get subs */
-        if ((err_info = sr_shmext_recover_sub_oper_get(conn, shm_mod))) {
-            sr_errinfo_free(&err_info);
-        }
-
-        /* oper poll subs */
-        if ((err_info = sr_shmext_recover_sub_oper_poll(conn, shm_mod))) {
-            sr_errinfo_free(&err_info);
-        }
-
-        /* notif subs */
-        if ((err_info = sr_shmext_recover_sub_notif(conn, shm_mod))) {
-            sr_errinfo_free(&err_info);
-        }
-
-        /* RPC ext subs */
-        if ((err_info = sr_shmext_recover_sub_rpc_ext(conn, shm_mod))) {
-            sr_errinfo_free(&err_info);
-        }
-
-        /* RPC subs */
-        shm_rpc = (sr_rpc_t *)(conn->mod_shm.addr + shm_mod->rpcs);
-        for (j = 0; j < shm_mod->rpc_count; ++j) {
-            if ((err_info = sr_shmext_recover_sub_rpc(conn, &shm_rpc[i]))) {
-                sr_errinfo_free(&err_info);
-            }
-        }
-    }
-}
-
 /**
  * @brief Check validity of SHM mod change subscriptions in an updated context.
  *
@@ -3007,6 +2706,9 @@ sr_shmext_oper_push_update(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, const char *m
         new_item->has_data = has_data;
     }
 
+    /* push oper data or their order changed */
+    sr_conn_ext_data_changed(conn, mod_name);
+
 cleanup_ext_shmmod_unlock:
     /* EXT WRITE UNLOCK */
     sr_shmext_conn_remap_unlock(conn, SR_LOCK_WRITE, 1, __func__);
@@ -3083,7 +2785,7 @@ cleanup:
 }
 
 sr_error_info_t *
-sr_shmext_oper_push_del(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, const char *UNUSED(mod_name), uint32_t sid,
+sr_shmext_oper_push_del(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, const char *mod_name, uint32_t sid,
         sr_lock_mode_t has_mod_locks)
 {
     sr_error_info_t *err_info = NULL;
@@ -3110,6 +2812,9 @@ sr_shmext_oper_push_del(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, const char *UNUS
     /* free the item */
     sr_shmrealloc_del(&conn->ext_shm, &shm_mod->oper_push_data, &shm_mod->oper_push_data_count, sizeof *oper_push, i, 0, 0);
 
+    /* push oper data removed */
+    sr_conn_ext_data_changed(conn, mod_name);
+
 cleanup_ext_unlock:
     /* EXT READ UNLOCK */
     sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 1, __func__);
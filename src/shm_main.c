@@ -31,6 +31,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <libyang/libyang.h>
@@ -57,6 +58,12 @@
  * to close the filehandle which releases the lock. Programs which do not cleanly
  * disconnect (eg crash) will have the lock removed automatically as the
  * terminated process is cleaned up.
+ *
+ * Every connection found alive refreshes its alive word in main SHM, which is then
+ * checked lock-free by any process and the lockfile is tested again only once the
+ * word is older than SR_CONN_ALIVE_CACHE_TIMEOUT. A clean disconnect clears the word
+ * so only a crashed connection can be reported alive, for at most that time. Main SHM
+ * is mapped for accessing the words while there are any connections in this process.
  */
 static struct {
     pthread_mutex_t list_lock;          /**< lock for accessing the connection list */
@@ -65,9 +72,11 @@ static struct {
         sr_cid_t cid;                   /**< CID of a connection in this process */
         int lock_fd;                    /**< locked fd of a connection in this process */
     } *list_head;                       /**< process connection list head */
+    sr_shm_t main_shm;                  /**< main SHM mapped while list_head is not empty, protected by list_lock */
 
     pthread_mutex_t create_lock;        /**< lock used for synchronizing new connection creation within the process */
-} conn_proc = {.list_lock = PTHREAD_MUTEX_INITIALIZER, .list_head = NULL, .create_lock = PTHREAD_MUTEX_INITIALIZER};
+} conn_proc = {.list_lock = PTHREAD_MUTEX_INITIALIZER, .list_head = NULL, .main_shm = SR_SHM_INITIALIZER,
+    .create_lock = PTHREAD_MUTEX_INITIALIZER};
 
 sr_error_info_t *
 sr_shmmain_check_dirs(void)
@@ -175,6 +184,98 @@ sr_shmmain_createunlock(int shm_lock)
     sr_munlock(&conn_proc.create_lock);
 }
 
+/**
+ * @brief Get the alive word of a connection in main SHM.
+ *
+ * @param[in] cid CID of the connection.
+ * @return Alive word, NULL if main SHM is not mapped.
+ */
+static ATOMIC64_T *
+sr_shmmain_conn_alive_word(sr_cid_t cid)
+{
+    sr_main_shm_t *main_shm = (sr_main_shm_t *)conn_proc.main_shm.addr;
+
+    if (!main_shm) {
+        return NULL;
+    }
+    return &main_shm->conn_alive[cid % SR_MAIN_SHM_CONN_ALIVE_COUNT];
+}
+
+/**
+ * @brief Get the current monotonic time for connection alive words.
+ *
+ * @return Current time in ms, may overflow.
+ */
+static uint32_t
+sr_shmmain_conn_alive_now(void)
+{
+    struct timespec ts;
+
+    sr_timeouttime_get(&ts, 0);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Check whether a connection was recently found alive, lock-free.
+ *
+ * @param[in] cid CID of the connection.
+ * @return Whether the connection alive word is fresh.
+ */
+static int
+sr_shmmain_conn_alive_is_fresh(sr_cid_t cid)
+{
+    ATOMIC64_T *word;
+    uint64_t val;
+
+    if (!(word = sr_shmmain_conn_alive_word(cid))) {
+        return 0;
+    }
+
+    val = ATOMIC_LOAD_RELAXED(*word);
+    if ((sr_cid_t)(val >> 32) != cid) {
+        /* never found alive or the word is used by another connection */
+        return 0;
+    }
+
+    return (uint32_t)(sr_shmmain_conn_alive_now() - (uint32_t)val) < SR_CONN_ALIVE_CACHE_TIMEOUT;
+}
+
+/**
+ * @brief Refresh the alive word of a connection found alive.
+ *
+ * @param[in] cid CID of the connection.
+ */
+static void
+sr_shmmain_conn_alive_refresh(sr_cid_t cid)
+{
+    ATOMIC64_T *word;
+
+    if (!(word = sr_shmmain_conn_alive_word(cid))) {
+        return;
+    }
+
+    ATOMIC_STORE_RELAXED(*word, ((uint64_t)cid << 32) | sr_shmmain_conn_alive_now());
+}
+
+/**
+ * @brief Clear the alive word of a disconnected connection, if it still belongs to it.
+ *
+ * @param[in] cid CID of the connection.
+ */
+static void
+sr_shmmain_conn_alive_clear(sr_cid_t cid)
+{
+    ATOMIC64_T *word;
+
+    if (!(word = sr_shmmain_conn_alive_word(cid))) {
+        return;
+    }
+
+    if ((sr_cid_t)(ATOMIC_LOAD_RELAXED(*word) >> 32) == cid) {
+        ATOMIC_STORE_RELAXED(*word, 0);
+    }
+}
+
 sr_error_info_t *
 sr_shmmain_conn_check(sr_cid_t cid, int *conn_alive, pid_t *pid)
 {
@@ -186,6 +287,12 @@ sr_shmmain_conn_check(sr_cid_t cid, int *conn_alive, pid_t *pid)
 
     assert(cid && conn_alive);
 
+    if (!pid && sr_shmmain_conn_alive_is_fresh(cid)) {
+        /* recently found alive */
+        *conn_alive = 1;
+        goto cleanup;
+    }
+
     /* CONN LIST LOCK */
     if ((err_info = sr_mlock(&conn_proc.list_lock, SR_CONN_LIST_LOCK_TIMEOUT, __func__, NULL, NULL))) {
         goto cleanup;
@@ -204,6 +311,7 @@ sr_shmmain_conn_check(sr_cid_t cid, int *conn_alive, pid_t *pid)
                 if (pid) {
                     *pid = getpid();
                 }
+                sr_shmmain_conn_alive_refresh(cid);
 
                 /* CONN LIST UNLOCK */
                 sr_munlock(&conn_proc.list_lock);
@@ -215,10 +323,11 @@ sr_shmmain_conn_check(sr_cid_t cid, int *conn_alive, pid_t *pid)
     /* CONN LIST UNLOCK */
     sr_munlock(&conn_proc.list_lock);
 
-    /* open the file to test the lock */
     if ((err_info = sr_path_conn_lockfile(cid, 0, &path))) {
         goto cleanup;
     }
+
+    /* open the file to test the lock */
     fd = sr_open(path, O_WRONLY, 0);
     if (fd == -1) {
         if (errno == ENOENT) {
@@ -268,6 +377,9 @@ sr_shmmain_conn_check(sr_cid_t cid, int *conn_alive, pid_t *pid)
         if (pid) {
             *pid = fl.l_pid;
         }
+
+        /* following checks need not test the lock for a while */
+        sr_shmmain_conn_alive_refresh(cid);
     }
 
 cleanup:
@@ -369,9 +481,19 @@ sr_shmmain_conn_list_add(sr_cid_t cid)
         goto error;
     }
 
+    if (!conn_proc.list_head) {
+        /* first connection of this process, map main SHM for the connection alive words */
+        if ((err_info = sr_shmmain_open(&conn_proc.main_shm, NULL))) {
+            /* CONN LIST UNLOCK */
+            sr_munlock(&conn_proc.list_lock);
+            goto error;
+        }
+    }
+
     /* insert at the head of the list */
     conn_item->_next = conn_proc.list_head;
     conn_proc.list_head = conn_item;
+    sr_shmmain_conn_alive_refresh(cid);
 
     /* CONN LIST UNLOCK */
     sr_munlock(&conn_proc.list_lock);
@@ -433,6 +555,14 @@ sr_shmmain_conn_list_del(sr_cid_t cid)
         ptr = ptr->_next;
     }
 
+    /* the connection is not alive anymore */
+    sr_shmmain_conn_alive_clear(cid);
+
+    if (!conn_proc.list_head) {
+        /* last connection of this process */
+        sr_shm_clear(&conn_proc.main_shm);
+    }
+
     /* CONN LIST UNLOCK */
     sr_munlock(&conn_proc.list_lock);
 
@@ -509,6 +639,7 @@ sr_shmmain_open(sr_shm_t *shm, int *created)
         ATOMIC_STORE_RELAXED(main_shm->new_sr_sid, 1);
         ATOMIC_STORE_RELAXED(main_shm->new_sub_id, 1);
         ATOMIC_STORE_RELAXED(main_shm->new_evpipe_num, 1);
+        ATOMIC_STORE_RELAXED(main_shm->sm_data_ver, 1);
         strncpy(main_shm->repo_path, sr_get_repo_path(), sizeof main_shm->repo_path - 1);
 
         /* remove leftover event pipes */
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -79,6 +80,7 @@ sr_shmmod_open(sr_shm_t *shm, int zero)
     }
     if (zero) {
         ((sr_mod_shm_t *)shm->addr)->mod_count = 0;
+        ((sr_mod_shm_t *)shm->addr)->ncn_mod_idx = 0;
     }
 
     return NULL;
@@ -302,6 +304,28 @@ sr_shmmod_fill(sr_shm_t *shm_mod, size_t shm_mod_idx, const struct lyd_node *sr_
     return NULL;
 }
 
+/**
+ * @brief Learn whether any datastore data may be needed to evaluate dependencies.
+ *
+ * @param[in] shm_deps Mod SHM dependencies.
+ * @param[in] shm_dep_count Dependency count.
+ * @return 0 if no data are ever needed, non-zero otherwise.
+ */
+static int
+sr_shmmod_deps_need_data(const sr_dep_t *shm_deps, uint16_t shm_dep_count)
+{
+    uint16_t i;
+
+    for (i = 0; i < shm_dep_count; ++i) {
+        if ((shm_deps[i].type != SR_DEP_XPATH) || shm_deps[i].xpath.target_mod_count) {
+            /* leafref and instance-identifier always reference data, XPath only if it has foreign target modules */
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief Fill mod SHM dependency information based on internal sysrepo data.
  *
@@ -630,6 +654,7 @@ sr_shmmod_add_rpcs(sr_shm_t *shm_mod, size_t shm_mod_idx, const struct lyd_node
                         return err_info;
                     }
                     SR_CHECK_INT_RET(dep_i != shm_rpcs[rpc_i].in_dep_count, err_info);
+                    shm_rpcs[rpc_i].in_data_deps = sr_shmmod_deps_need_data(shm_deps, shm_rpcs[rpc_i].in_dep_count);
                 } else if (!strcmp(sr_op->schema->name, "out")) {
                     LY_LIST_FOR(lyd_child(sr_op), sr_op_dep) {
                         /* count op output data deps first */
@@ -647,6 +672,7 @@ sr_shmmod_add_rpcs(sr_shm_t *shm_mod, size_t shm_mod_idx, const struct lyd_node
                         return err_info;
                     }
                     SR_CHECK_INT_RET(dep_i != shm_rpcs[rpc_i].out_dep_count, err_info);
+                    shm_rpcs[rpc_i].out_data_deps = sr_shmmod_deps_need_data(shm_deps, shm_rpcs[rpc_i].out_dep_count);
                 }
             }
 
@@ -799,6 +825,7 @@ sr_shmmod_store_modules(sr_shm_t *shm_mod, const struct lyd_node *sr_mods)
 
     /* set module count */
     ((sr_mod_shm_t *)shm_mod->addr)->mod_count = set->count;
+    ((sr_mod_shm_t *)shm_mod->addr)->ncn_mod_idx = set->count;
 
     /* add all modules into SHM */
     for (i = 0; i < set->count; ++i) {
@@ -811,6 +838,11 @@ sr_shmmod_store_modules(sr_shm_t *shm_mod, const struct lyd_node *sr_mods)
         if ((err_info = sr_shmmod_fill(shm_mod, i, sr_mod, smod))) {
             goto cleanup;
         }
+
+        if (!strcmp(lyd_get_value(lyd_child(sr_mod)), "ietf-netconf-notifications")) {
+            /* remember its index */
+            ((sr_mod_shm_t *)shm_mod->addr)->ncn_mod_idx = i;
+        }
     }
 
     /*
@@ -1081,24 +1113,13 @@ sr_shmmod_ctx_load_modules(sr_mod_shm_t *mod_shm, struct ly_ctx *ly_ctx, const s
     return NULL;
 }
 
-sr_error_info_t *
-sr_shmmod_get_rpc_deps(sr_mod_shm_t *mod_shm, const char *path, int output, sr_dep_t **shm_deps, uint16_t *shm_dep_count)
+void
+sr_shmmod_get_rpc_deps(sr_mod_shm_t *mod_shm, const sr_rpc_t *shm_rpc, int output, sr_dep_t **shm_deps,
+        uint16_t *shm_dep_count)
 {
-    sr_error_info_t *err_info = NULL;
-    sr_rpc_t *shm_rpc;
-
-    *shm_deps = NULL;
-    *shm_dep_count = 0;
-
-    /* find the RPC in SHM */
-    shm_rpc = sr_shmmod_find_rpc(mod_shm, path);
-    SR_CHECK_INT_RET(!shm_rpc, err_info);
-
     /* collect dependencies */
     *shm_deps = (sr_dep_t *)(((char *)mod_shm) + (output ? shm_rpc->out_deps : shm_rpc->in_deps));
     *shm_dep_count = (output ? shm_rpc->out_dep_count : shm_rpc->in_dep_count);
-
-    return NULL;
 }
 
 sr_error_info_t *
@@ -1736,6 +1757,145 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Copy of a single module between datastores.
+ */
+struct sr_shmmod_copy_s {
+    const struct lys_module *ly_mod;
+    const struct sr_ds_handle_s *sds_handle;
+    sr_datastore_t sds;
+    const struct sr_ds_handle_s *tds_handle;
+    sr_datastore_t tds;
+    sr_error_info_t *err_info;
+};
+
+/**
+ * @brief Shared context of the copy threads.
+ */
+struct sr_shmmod_copy_ctx_s {
+    pthread_mutex_t lock;
+    struct sr_shmmod_copy_s *copies;
+    uint32_t count;
+    uint32_t next;              /**< index of the next copy to perform, protected by lock */
+    int failed;                 /**< set if any copy failed, protected by lock */
+};
+
+/**
+ * @brief Thread copying modules between datastores.
+ *
+ * @param[in] arg Copy context.
+ * @return NULL.
+ */
+static void *
+sr_shmmod_copy_thread(void *arg)
+{
+    struct sr_shmmod_copy_ctx_s *ctx = arg;
+    sr_error_info_t *err_info = NULL;
+    struct sr_shmmod_copy_s *copy = NULL;
+
+    while (1) {
+        /* LOCK */
+        if ((err_info = sr_mlock(&ctx->lock, -1, __func__, NULL, NULL))) {
+            sr_errinfo_free(&err_info);
+            break;
+        }
+
+        if (copy && copy->err_info) {
+            /* previous copy failed */
+            ctx->failed = 1;
+        }
+        if (ctx->failed || (ctx->next == ctx->count)) {
+            /* UNLOCK */
+            sr_munlock(&ctx->lock);
+            break;
+        }
+        copy = &ctx->copies[ctx->next++];
+
+        /* UNLOCK */
+        sr_munlock(&ctx->lock);
+
+        /* copy the module */
+        copy->err_info = sr_shmmod_copy_mod(copy->ly_mod, copy->sds_handle, copy->sds, copy->tds_handle, copy->tds);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Copy modules between datastores, in parallel if possible.
+ *
+ * @param[in] copies Array of independent copies to perform, ordered by priority.
+ * @param[in] count Count of @p copies.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmmod_copy_mods(struct sr_shmmod_copy_s *copies, uint32_t count)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_shmmod_copy_ctx_s ctx = {0};
+    pthread_t *tids = NULL;
+    uint32_t i, thread_count, started = 0;
+    long cpus;
+    int r;
+
+    /* the modules are independent so use a thread for each CPU */
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    thread_count = (cpus > 1) ? (uint32_t)cpus : 1;
+    if (thread_count > count) {
+        thread_count = count;
+    }
+
+    if (thread_count < 2) {
+        /* no point in creating threads */
+        for (i = 0; i < count; ++i) {
+            if ((err_info = sr_shmmod_copy_mod(copies[i].ly_mod, copies[i].sds_handle, copies[i].sds,
+                    copies[i].tds_handle, copies[i].tds))) {
+                return err_info;
+            }
+        }
+        return NULL;
+    }
+
+    if ((err_info = sr_mutex_init(&ctx.lock, 0))) {
+        return err_info;
+    }
+    ctx.copies = copies;
+    ctx.count = count;
+
+    tids = malloc(thread_count * sizeof *tids);
+    SR_CHECK_MEM_GOTO(!tids, err_info, cleanup);
+
+    for (started = 0; started < thread_count; ++started) {
+        if ((r = pthread_create(&tids[started], NULL, sr_shmmod_copy_thread, &ctx))) {
+            if (!started) {
+                sr_errinfo_new(&err_info, SR_ERR_SYS, "Creating a new thread failed (%s).", strerror(r));
+                goto cleanup;
+            }
+
+            /* continue with the threads created so far */
+            break;
+        }
+    }
+
+    for (i = 0; i < started; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+
+    /* collect errors */
+    for (i = 0; i < ctx.next; ++i) {
+        sr_errinfo_merge(&err_info, copies[i].err_info);
+    }
+    if (!err_info && (ctx.next < count)) {
+        /* threads stopped unexpectedly */
+        SR_ERRINFO_INT(&err_info);
+    }
+
+cleanup:
+    free(tids);
+    pthread_mutex_destroy(&ctx.lock);
+    return err_info;
+}
+
 /**
  * @brief qsort(3) compar callback implementation.
  */
@@ -1760,12 +1920,15 @@ sr_shmmod_reboot_init(sr_conn_ctx_t *conn, int initialized)
     sr_mod_t **smods = NULL;
     const struct lys_module *ly_mod;
     const struct sr_ds_handle_s *ds_handle[SR_DS_READ_COUNT];
+    struct sr_shmmod_copy_s *copies = NULL;
     sr_datastore_t ds;
-    uint32_t i;
+    uint32_t i, copy_count = 0;
 
     mod_shm = SR_CONN_MOD_SHM(conn);
     smods = malloc(mod_shm->mod_count * sizeof *smods);
     SR_CHECK_MEM_GOTO(!smods, err_info, cleanup);
+    copies = malloc(mod_shm->mod_count * sizeof *copies);
+    SR_CHECK_MEM_GOTO(!copies, err_info, cleanup);
 
     /* prepare SHM mod array */
     for (i = 0; i < mod_shm->mod_count; ++i) {
@@ -1801,17 +1964,83 @@ sr_shmmod_reboot_init(sr_conn_ctx_t *conn, int initialized)
             continue;
         }
 
-        /* copy startup to running */
-        if ((err_info = sr_shmmod_copy_mod(ly_mod, ds_handle[SR_DS_STARTUP], SR_DS_STARTUP, ds_handle[SR_DS_RUNNING],
-                SR_DS_RUNNING))) {
-            goto cleanup;
-        }
+        /* copy startup to running, later */
+        copies[copy_count].ly_mod = ly_mod;
+        copies[copy_count].sds_handle = ds_handle[SR_DS_STARTUP];
+        copies[copy_count].sds = SR_DS_STARTUP;
+        copies[copy_count].tds_handle = ds_handle[SR_DS_RUNNING];
+        copies[copy_count].tds = SR_DS_RUNNING;
+        copies[copy_count].err_info = NULL;
+        ++copy_count;
+    }
+
+    /* all the plugins are initialized, the modules can be copied independently */
+    if ((err_info = sr_shmmod_copy_mods(copies, copy_count))) {
+        goto cleanup;
     }
 
     SR_LOG_INF("Datastore copied from <startup> to <running>.");
 
 cleanup:
     free(smods);
+    free(copies);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_shmmod_modinfo_copy(struct sr_mod_info_s *mod_info, sr_datastore_t sds)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_mod_s *mod;
+    struct sr_shmmod_copy_s *copies = NULL;
+    uint32_t i, copy_count = 0;
+
+    assert((mod_info->ds == SR_DS_STARTUP) || (mod_info->ds == SR_DS_RUNNING));
+
+    copies = malloc(mod_info->mod_count * sizeof *copies);
+    SR_CHECK_MEM_GOTO(!copies, err_info, cleanup);
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if (!(mod->state & MOD_INFO_REQ)) {
+            continue;
+        }
+
+        /* find the source DS plugin */
+        if ((err_info = sr_ds_handle_find(mod_info->conn->mod_shm.addr + mod->shm_mod->plugins[sds], mod_info->conn,
+                &copies[copy_count].sds_handle))) {
+            goto cleanup;
+        }
+        copies[copy_count].ly_mod = mod->ly_mod;
+        copies[copy_count].sds = sds;
+        if ((mod_info->ds == SR_DS_RUNNING) && !mod->ds_handle[mod_info->ds]) {
+            /* 'running' disabled, use 'startup' */
+            copies[copy_count].tds = SR_DS_STARTUP;
+        } else {
+            copies[copy_count].tds = mod_info->ds;
+        }
+        copies[copy_count].tds_handle = mod->ds_handle[copies[copy_count].tds];
+        copies[copy_count].err_info = NULL;
+        ++copy_count;
+    }
+
+    /* the modules are locked and stored separately so they can be copied independently */
+    if ((err_info = sr_shmmod_copy_mods(copies, copy_count))) {
+        goto cleanup;
+    }
+
+    if (mod_info->ds == SR_DS_RUNNING) {
+        for (i = 0; i < mod_info->mod_count; ++i) {
+            mod = &mod_info->mods[i];
+            if (mod->state & MOD_INFO_REQ) {
+                /* update the cache ID because data were modified, ignored if data_version callback is used instead */
+                mod->shm_mod->run_cache_id++;
+            }
+        }
+    }
+
+cleanup:
+    free(copies);
     return err_info;
 }
 
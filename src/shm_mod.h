@@ -95,13 +95,12 @@ sr_error_info_t *sr_shmmod_ctx_load_modules(sr_mod_shm_t *mod_shm, struct ly_ctx
  * @brief Get SHM dependencies of an RPC/action.
  *
  * @param[in] mod_shm Mod SHM.
- * @param[in] path Path identifying the RPC/action.
+ * @param[in] shm_rpc SHM RPC/action.
  * @param[in] output Whether this is the RPC/action output or input.
  * @param[out] shm_deps Mod SHM dependencies.
  * @param[out] shm_dep_count Dependency count.
- * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_shmmod_get_rpc_deps(sr_mod_shm_t *mod_shm, const char *path, int output, sr_dep_t **shm_deps,
+void sr_shmmod_get_rpc_deps(sr_mod_shm_t *mod_shm, const sr_rpc_t *shm_rpc, int output, sr_dep_t **shm_deps,
         uint16_t *shm_dep_count);
 
 /**
@@ -253,6 +252,16 @@ sr_error_info_t *sr_shmmod_update_replay_support(sr_mod_shm_t *mod_shm, const st
  */
 sr_error_info_t *sr_shmmod_reboot_init(sr_conn_ctx_t *conn, int initialized);
 
+/**
+ * @brief Copy data of all the required modules in mod info from a datastore directly into the mod info datastore.
+ * The data are neither validated nor any subscribers notified. Modules must be WRITE locked.
+ *
+ * @param[in] mod_info Mod info with the target datastore.
+ * @param[in] sds Source datastore.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmmod_modinfo_copy(struct sr_mod_info_s *mod_info, sr_datastore_t sds);
+
 /**
  * @brief Set/get change priority of a module.
  *
@@ -20,6 +20,7 @@
 #include "shm_sub.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
@@ -255,6 +256,9 @@ sr_shmsub_data_open_remap(const char *name, const char *suffix1, int64_t suffix2
             SR_ERRINFO_SYSERRPATH(&err_info, "open", path);
             goto cleanup;
         }
+
+        /* may hold large data */
+        shm->huge_pages = 1;
     }
 
     /* map it */
@@ -371,7 +375,7 @@ sr_shmsub_notify_new_wrlock(sr_sub_shm_t *sub_shm, const char *shm_name, sr_sub_
     while (!ret && (sub_shm->lock.readers[0] || (ATOMIC_LOAD_RELAXED(sub_shm->event) &&
             (ATOMIC_LOAD_RELAXED(sub_shm->event) != lock_event)))) {
         /* COND WAIT */
-        ret = sr_cond_clockwait(&sub_shm->lock.cond, &sub_shm->lock.mutex, COMPAT_CLOCK_ID, &timeout_abs);
+        ret = sr_rwlock_cond_wait(&sub_shm->lock, SR_RWLOCK_WAIT_WRITE_ALL, &timeout_abs);
     }
 
     if (!sub_shm->lock.readers[0]) {
@@ -484,7 +488,7 @@ _sr_shmsub_notify_wait_wr(sr_sub_shm_t *sub_shm, sr_sub_event_t event, uint32_t
     while (!ret && (sub_shm->lock.readers[0] || sub_shm->lock.writer ||
             (ATOMIC_LOAD_RELAXED(sub_shm->event) && !SR_IS_NOTIFY_EVENT(ATOMIC_LOAD_RELAXED(sub_shm->event))))) {
         /* COND WAIT */
-        ret = sr_cond_clockwait(&sub_shm->lock.cond, &sub_shm->lock.mutex, COMPAT_CLOCK_ID, timeout_abs);
+        ret = sr_rwlock_cond_wait(&sub_shm->lock, SR_RWLOCK_WAIT_WRITE_ALL, timeout_abs);
     }
     /* we are holding the mutex but no lock flags are set */
 
@@ -1210,6 +1214,86 @@ sr_shmsub_change_notify_diff_has_changes(struct sr_mod_info_mod_s *mod, const st
     return 0;
 }
 
+/**
+ * @brief Print a diff for a change event as separate LYB chunks of all the instances of each top-level node
+ * so that the listeners can parse only the subtrees they need.
+ *
+ * @param[in,out] diff Diff to print, its top-level siblings are relinked.
+ * @param[out] diff_data Printed diff in the event data format (::sr_ev_data_push()).
+ * @param[out] diff_data_len Length of @p diff_data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_change_notify_print_diff(struct lyd_node **diff, char **diff_data, uint32_t *diff_data_len)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *node, *next, *top = NULL, *new_diff = NULL;
+    char *lyb = NULL, *chunk = NULL, *top_name = NULL;
+    void *ev_data = NULL;
+    uint32_t lyb_len, name_len;
+
+    while (*diff) {
+        /* unlink all the instances of the first top-level node */
+        node = *diff;
+        do {
+            next = node->next;
+            *diff = next;
+            lyd_unlink_tree(node);
+            lyd_insert_sibling(top, node, &top);
+            node = next;
+        } while (node && top->schema && (node->schema == top->schema));
+
+        /* print them */
+        if (asprintf(&top_name, "%s:%s", lyd_owner_module(top)->name, LYD_NAME(top)) == -1) {
+            SR_ERRINFO_MEM(&err_info);
+            goto cleanup;
+        }
+        if ((err_info = sr_lyd_print_data(top, LYD_LYB, 0, -1, &lyb, &lyb_len))) {
+            goto cleanup;
+        }
+
+        /* add the chunk "module:name" and LYB */
+        name_len = strlen(top_name) + 1;
+        chunk = malloc(name_len + lyb_len);
+        SR_CHECK_MEM_GOTO(!chunk, err_info, cleanup);
+        memcpy(chunk, top_name, name_len);
+        memcpy(chunk + name_len, lyb, lyb_len);
+        if ((err_info = sr_ev_data_push(&ev_data, name_len + lyb_len, chunk))) {
+            goto cleanup;
+        }
+
+        /* relink them into the new diff */
+        lyd_insert_sibling(new_diff, top, &new_diff);
+        top = NULL;
+        free(top_name);
+        top_name = NULL;
+        free(lyb);
+        lyb = NULL;
+        free(chunk);
+        chunk = NULL;
+    }
+
+    *diff_data = ev_data;
+    *diff_data_len = sr_ev_data_size(ev_data);
+    ev_data = NULL;
+
+cleanup:
+    /* relink everything back */
+    if (top) {
+        lyd_insert_sibling(new_diff, top, &new_diff);
+    }
+    if (*diff) {
+        lyd_insert_sibling(new_diff, *diff, &new_diff);
+    }
+    *diff = new_diff;
+
+    free(top_name);
+    free(lyb);
+    free(chunk);
+    free(ev_data);
+    return err_info;
+}
+
 /**
  * @brief Get the module diff or full dif in LYB.
  *
@@ -1228,7 +1312,7 @@ static sr_error_info_t *
 sr_shmsub_change_notify_get_diff(struct lyd_node *diff, const struct lys_module *ly_mod, int sub_opts, uint32_t *reuse_diff,
         char **full_diff_lyb, uint32_t *full_diff_lyb_len, char **diff_lyb, uint32_t *diff_lyb_len, int *free_diff)
 {
-    sr_error_info_t *err_info = NULL;
+    sr_error_info_t *err_info = NULL, *tmp_err;
     struct lyd_node *mod_diff;
     int single_module = !(sub_opts & SR_SUBSCR_CHANGE_ALL_MODULES);
 
@@ -1252,18 +1336,19 @@ sr_shmsub_change_notify_get_diff(struct lyd_node *diff, const struct lys_module
         assert(mod_diff);
 
         /* print it */
-        if ((err_info = sr_lyd_print_data(mod_diff, LYD_LYB, 0, -1, diff_lyb, diff_lyb_len))) {
-            goto cleanup;
-        }
+        err_info = sr_shmsub_change_notify_print_diff(&mod_diff, diff_lyb, diff_lyb_len);
         *free_diff = 1;
 
         /* relink to the diff */
-        if ((err_info = sr_lyd_insert_sibling(diff, mod_diff, &diff))) {
+        if ((tmp_err = sr_lyd_insert_sibling(diff, mod_diff, &diff))) {
+            sr_errinfo_merge(&err_info, tmp_err);
+        }
+        if (err_info) {
             goto cleanup;
         }
     } else {
         /* print the full diff if not before */
-        if (!*full_diff_lyb && (err_info = sr_lyd_print_data(diff, LYD_LYB, 0, -1, full_diff_lyb, full_diff_lyb_len))) {
+        if (!*full_diff_lyb && (err_info = sr_shmsub_change_notify_print_diff(&diff, full_diff_lyb, full_diff_lyb_len))) {
             goto cleanup;
         }
 
@@ -2343,6 +2428,132 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Check whether a datastore can be reset to factory-default by copying the stored data directly,
+ * without generating a diff, validation, and notifying subscribers.
+ *
+ * It is possible if all the modules with data are being reset so the result is the whole factory-default
+ * datastore, which is always valid, and there are no change subscriptions to notify. Subscriptions are checked
+ * without any locks so they must be checked again once the modules are locked.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod_info Mod info with the modules to reset.
+ * @param[in] ds Datastore to reset.
+ * @return Whether the datastore can be reset directly.
+ */
+static int
+sr_shmsub_factory_reset_is_direct(sr_conn_ctx_t *conn, const struct sr_mod_info_s *mod_info, sr_datastore_t ds)
+{
+    const struct lys_module *ly_mod;
+    sr_mod_t *shm_mod;
+    uint32_t i, idx = 0, mod_count = 0, reset_count = 0;
+
+    /* count all the modules that can be reset, as in sr_rpc_internal_input_update() */
+    while ((ly_mod = ly_ctx_get_module_iter(conn->ly_ctx, &idx))) {
+        if (!ly_mod->implemented || !strcmp(ly_mod->name, "sysrepo") || !strcmp(ly_mod->name, "ietf-netconf") ||
+                !sr_module_has_data(ly_mod, 0)) {
+            continue;
+        }
+        ++mod_count;
+    }
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        if (!strcmp(mod_info->mods[i].ly_mod->name, "ietf-netconf")) {
+            continue;
+        }
+        ++reset_count;
+
+        /* find the module in SHM */
+        shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(conn), mod_info->mods[i].ly_mod->name);
+        if (!shm_mod || shm_mod->change_sub[ds].sub_count) {
+            /* subscribers need to be notified */
+            return 0;
+        }
+    }
+
+    return (reset_count == mod_count) ? 1 : 0;
+}
+
+/**
+ * @brief Check whether any of the modules being reset directly has change subscriptions.
+ *
+ * Must be called with the modules locked and with CHANGE SUB READ lock held.
+ *
+ * @param[in] mod_info Mod info with the modules to reset.
+ * @return Whether there are any change subscriptions.
+ */
+static int
+sr_shmsub_factory_reset_has_subs(const struct sr_mod_info_s *mod_info)
+{
+    uint32_t i;
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        if ((mod_info->mods[i].state & MOD_INFO_REQ) && mod_info->mods[i].shm_mod->change_sub[mod_info->ds].sub_count) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Re-initialize mod info for working with another datastore.
+ *
+ * @param[in] mod_info Mod info to re-initialize.
+ * @param[in] ds Datastore to use.
+ */
+static void
+sr_shmsub_factory_reset_modinfo_reinit(struct sr_mod_info_s *mod_info, sr_datastore_t ds)
+{
+    uint32_t i;
+
+    mod_info->ds = ds;
+    mod_info->ds2 = ds;
+    lyd_free_siblings(mod_info->notify_diff);
+    mod_info->notify_diff = NULL;
+    mod_info->ds_diff = NULL;
+    lyd_free_siblings(mod_info->data);
+    mod_info->data = NULL;
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod_info->mods[i].state = MOD_INFO_NEW;
+        mod_info->mods[i].reuse_diff = 0;
+    }
+}
+
+/**
+ * @brief Load factory-default data of the modules to reset.
+ *
+ * @param[in] mod_info Mod info with the modules to reset.
+ * @param[out] data Factory-default data for startup and running.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_factory_reset_load(struct sr_mod_info_s *mod_info, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    sr_shmsub_factory_reset_modinfo_reinit(mod_info, SR_DS_FACTORY_DEFAULT);
+
+    /* add modules into mod_info, READ lock */
+    if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_PERM_NO, NULL, 0, 0, 0))) {
+        return err_info;
+    }
+
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(mod_info);
+
+    if (mod_info->data) {
+        /* keep the data for both DS */
+        if ((err_info = sr_lyd_dup(mod_info->data, NULL, LYD_DUP_RECURSIVE, 1, &data[SR_DS_STARTUP]))) {
+            return err_info;
+        }
+        data[SR_DS_RUNNING] = mod_info->data;
+        mod_info->data = NULL;
+    }
+
+    return NULL;
+}
+
 /**
  * @brief Call internal RPC/action "callback".
  *
@@ -2360,7 +2571,8 @@ sr_shmsub_rpc_internal_call_callback(sr_conn_ctx_t *conn, const struct lyd_node
     struct lyd_node *child;
     const struct lys_module *ly_mod;
     sr_datastore_t ds;
-    int reset_ds[2] = {0};
+    int reset_ds[2] = {0}, direct_ds[2] = {0}, data_loaded = 0;
+    sr_lock_mode_t change_sub_lock = SR_LOCK_NONE;
     uint32_t i;
 
     assert(input->schema->nodetype & (LYS_RPC | LYS_ACTION));
@@ -2424,21 +2636,18 @@ sr_shmsub_rpc_internal_call_callback(sr_conn_ctx_t *conn, const struct lyd_node
         }
     }
 
-    /* add modules into mod_info, READ lock */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_PERM_NO, NULL, 0, 0, 0))) {
-        goto cleanup;
+    /* learn which datastores can be reset directly */
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
+        direct_ds[ds] = reset_ds[ds] && sr_shmsub_factory_reset_is_direct(conn, &mod_info, ds);
     }
 
-    /* MODULES UNLOCK */
-    sr_shmmod_modinfo_unlock(&mod_info);
-
-    if (mod_info.data) {
-        /* keep the data for both DS */
-        if ((err_info = sr_lyd_dup(mod_info.data, NULL, LYD_DUP_RECURSIVE, 1, &data[0]))) {
+    if ((reset_ds[SR_DS_STARTUP] && !direct_ds[SR_DS_STARTUP]) ||
+            (reset_ds[SR_DS_RUNNING] && !direct_ds[SR_DS_RUNNING])) {
+        /* load the factory-default data */
+        if ((err_info = sr_shmsub_factory_reset_load(&mod_info, data))) {
             goto cleanup;
         }
-        data[1] = mod_info.data;
-        mod_info.data = NULL;
+        data_loaded = 1;
     }
 
     for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
@@ -2448,32 +2657,76 @@ sr_shmsub_rpc_internal_call_callback(sr_conn_ctx_t *conn, const struct lyd_node
         }
 
         /* re-init mod_info manually */
-        mod_info.ds = ds;
-        mod_info.ds2 = ds;
-        lyd_free_siblings(mod_info.notify_diff);
-        mod_info.notify_diff = NULL;
-        mod_info.ds_diff = NULL;
-        lyd_free_siblings(mod_info.data);
-        mod_info.data = NULL;
-        for (i = 0; i < mod_info.mod_count; ++i) {
-            mod_info.mods[i].state = MOD_INFO_NEW;
-            mod_info.mods[i].reuse_diff = 0;
-        }
-
-        /* add modules with dependencies into mod_info */
-        if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO,
-                NULL, 0, 0, 0))) {
-            goto cleanup;
-        }
+        sr_shmsub_factory_reset_modinfo_reinit(&mod_info, ds);
 
-        /* update affected data and create corresponding diff, data are spent */
-        if ((err_info = sr_modinfo_replace(&mod_info, &data[ds]))) {
-            goto cleanup;
+        if (direct_ds[ds]) {
+            /* add modules into mod_info, WRITE lock */
+            if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_WRITE, SR_MI_DATA_NO | SR_MI_PERM_NO, NULL, 0, 0,
+                    0))) {
+                goto cleanup;
+            }
+
+            /* all the modules are going to be changed */
+            for (i = 0; i < mod_info.mod_count; ++i) {
+                if (mod_info.mods[i].state & MOD_INFO_REQ) {
+                    mod_info.mods[i].state |= MOD_INFO_CHANGED;
+                }
+            }
+
+            /* CHANGE SUB READ LOCK */
+            if ((err_info = sr_modinfo_changesub_rdlock(&mod_info))) {
+                goto cleanup;
+            }
+            change_sub_lock = SR_LOCK_READ;
+
+            if (sr_shmsub_factory_reset_has_subs(&mod_info)) {
+                /* a change subscription was added meanwhile, subscribers need to be notified */
+                direct_ds[ds] = 0;
+
+                /* CHANGE SUB READ UNLOCK */
+                sr_modinfo_changesub_rdunlock(&mod_info);
+                change_sub_lock = SR_LOCK_NONE;
+
+                /* MODULES UNLOCK */
+                sr_shmmod_modinfo_unlock(&mod_info);
+
+                if (!data_loaded) {
+                    /* load the factory-default data */
+                    if ((err_info = sr_shmsub_factory_reset_load(&mod_info, data))) {
+                        goto cleanup;
+                    }
+                    data_loaded = 1;
+                }
+                sr_shmsub_factory_reset_modinfo_reinit(&mod_info, ds);
+            } else {
+                /* copy the stored factory-default data directly */
+                if ((err_info = sr_shmmod_modinfo_copy(&mod_info, SR_DS_FACTORY_DEFAULT))) {
+                    goto cleanup;
+                }
+
+                /* CHANGE SUB READ UNLOCK */
+                sr_modinfo_changesub_rdunlock(&mod_info);
+                change_sub_lock = SR_LOCK_NONE;
+            }
         }
 
-        /* notify all the subscribers and store the changes */
-        if ((err_info = sr_changes_notify_store(&mod_info, NULL, 0, SR_CHANGE_CB_TIMEOUT, &cb_err_info)) || cb_err_info) {
-            goto cleanup;
+        if (!direct_ds[ds]) {
+            /* add modules with dependencies into mod_info */
+            if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE |
+                    SR_MI_PERM_NO, NULL, 0, 0, 0))) {
+                goto cleanup;
+            }
+
+            /* update affected data and create corresponding diff, data are spent */
+            if ((err_info = sr_modinfo_replace(&mod_info, &data[ds]))) {
+                goto cleanup;
+            }
+
+            /* notify all the subscribers and store the changes */
+            if ((err_info = sr_changes_notify_store(&mod_info, NULL, 0, SR_CHANGE_CB_TIMEOUT, &cb_err_info)) ||
+                    cb_err_info) {
+                goto cleanup;
+            }
         }
 
         if (ds == SR_DS_RUNNING) {
@@ -2493,6 +2746,11 @@ sr_shmsub_rpc_internal_call_callback(sr_conn_ctx_t *conn, const struct lyd_node
     }
 
 cleanup:
+    if (change_sub_lock) {
+        /* CHANGE SUB READ UNLOCK */
+        sr_modinfo_changesub_rdunlock(&mod_info);
+    }
+
     /* MODULES UNLOCK */
     sr_shmmod_modinfo_unlock(&mod_info);
 
@@ -3386,6 +3644,9 @@ sr_shmsub_change_listen_relock(sr_sub_shm_t *sub_shm, sr_lock_mode_t mode, struc
                 sr_shmsub_change_listen_event_is_valid(SR_SUB_EV_ABORT, sub->opts)) {
             /* update session */
             ev_sess->ev = SR_SUB_EV_ABORT;
+            if ((*err_info = sr_session_ev_diff_materialize(ev_sess))) {
+                return 1;
+            }
             if ((*err_info = sr_lyd_diff_reverse_all(ev_sess->dt[ev_sess->ds].diff, &abort_diff))) {
                 SR_ERRINFO_INT(err_info);
                 return 1;
@@ -3409,6 +3670,158 @@ sr_shmsub_change_listen_relock(sr_sub_shm_t *sub_shm, sr_lock_mode_t mode, struc
     return 0;
 }
 
+/**
+ * @brief Accumulate a done event diff of a coalescing change subscription.
+ *
+ * @param[in] sub Change subscription.
+ * @param[in] diff Event diff.
+ * @param[in] request_id Event request ID.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_change_listen_coalesce(struct modsub_changesub_s *sub, const struct lyd_node *diff, uint32_t request_id)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *coalesce_diff = NULL;
+
+    if (sub->coalesce_lyb) {
+        /* parse the previously accumulated changes */
+        if ((err_info = sr_lyd_parse_data(LYD_CTX(diff), sub->coalesce_lyb, NULL, LYD_LYB,
+                LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT | LYD_PARSE_ORDERED, 0, &coalesce_diff))) {
+            goto cleanup;
+        }
+    } else {
+        /* first accumulated event */
+        sr_timeouttime_get(&sub->coalesce_since, 0);
+        sub->coalesce_count = 0;
+    }
+
+    /* merge the new changes */
+    if ((err_info = sr_lyd_diff_merge_all(&coalesce_diff, diff))) {
+        goto cleanup;
+    }
+
+    /* store them again, the changes may have also cancelled each other out */
+    free(sub->coalesce_lyb);
+    sub->coalesce_lyb = NULL;
+    if (coalesce_diff && (err_info = sr_lyd_print_data(coalesce_diff, LYD_LYB, 0, -1, &sub->coalesce_lyb, NULL))) {
+        goto cleanup;
+    }
+    sub->coalesce_request_id = request_id;
+    ++sub->coalesce_count;
+    sr_timeouttime_get(&sub->coalesce_last, 0);
+
+cleanup:
+    lyd_free_all(coalesce_diff);
+    return err_info;
+}
+
+/**
+ * @brief Check whether a change subscription XPath may select any diff nodes of a top-level node.
+ *
+ * @param[in] xpath Subscription XPath.
+ * @param[in] top_name Top-level node name in the form "module:name".
+ * @return Whether the subtrees are needed or not.
+ */
+static int
+sr_shmsub_change_listen_xpath_needs_top(const char *xpath, const char *top_name)
+{
+    const char *ptr, *mod, *name;
+    int mod_len, len, pred_depth = 0, top_mod_len;
+    char quot = 0;
+
+    if (!xpath || (xpath[0] != '/') || (xpath[1] == '/')) {
+        /* no filter or not beginning with a top-level node */
+        return 1;
+    }
+
+    /* any union, function, or absolute path in a predicate may depend on other top-level nodes */
+    for (ptr = xpath; ptr[0]; ++ptr) {
+        if (quot) {
+            if (ptr[0] == quot) {
+                quot = 0;
+            }
+        } else if ((ptr[0] == '\'') || (ptr[0] == '\"')) {
+            quot = ptr[0];
+        } else if (ptr[0] == '[') {
+            ++pred_depth;
+        } else if (ptr[0] == ']') {
+            --pred_depth;
+        } else if ((ptr[0] == '|') || (ptr[0] == '(') || !strncmp(ptr, "::", 2) || !strncmp(ptr, "..", 2) ||
+                (pred_depth && (ptr[0] == '/'))) {
+            return 1;
+        }
+    }
+
+    /* first node */
+    ptr = sr_xpath_next_qname(xpath + 1, &mod, &mod_len, &name, &len);
+    if (!mod || !len || ((ptr[0] != '/') && (ptr[0] != '[') && ptr[0]) || ((name[0] != '*') && !isalpha(name[0]) &&
+            (name[0] != '_'))) {
+        return 1;
+    }
+
+    top_mod_len = strchr(top_name, ':') - top_name;
+    if ((mod_len != top_mod_len) || strncmp(mod, top_name, mod_len)) {
+        /* different module */
+        return 0;
+    }
+    if (name[0] == '*') {
+        /* any node of the module */
+        return 1;
+    }
+    return !strncmp(name, top_name + top_mod_len + 1, len) && !top_name[top_mod_len + 1 + len];
+}
+
+/**
+ * @brief Parse the event diff from sub SHM. Only subtrees of top-level nodes possibly selected by any subscription
+ * are parsed, the rest is stored in the session to be parsed on demand.
+ *
+ * @param[in] change_subs Module change subscriptions.
+ * @param[in] diff_data Event diff in SHM.
+ * @param[in] ev_sess Event session to store the diff in.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_change_listen_parse_diff(struct modsub_change_s *change_subs, const char *diff_data, sr_session_ctx_t *ev_sess)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *tree;
+    char *chunk, *lyb;
+    uint32_t i, j, size;
+
+    for (i = 0; !sr_ev_data_get(diff_data, i, &size, (void **)&chunk); ++i) {
+        /* learn whether any subscription needs these subtrees */
+        for (j = 0; j < change_subs->sub_count; ++j) {
+            if ((change_subs->subs[j].opts & (SR_SUBSCR_DONE_COALESCE | SR_SUBSCR_MIRROR)) ||
+                    sr_shmsub_change_listen_xpath_needs_top(change_subs->subs[j].xpath, chunk)) {
+                /* coalescing and mirroring require the full diff */
+                break;
+            }
+        }
+
+        if (j == change_subs->sub_count) {
+            /* keep for later */
+            if ((err_info = sr_ev_data_push(&ev_sess->ev_data.diff_lazy, size, chunk))) {
+                return err_info;
+            }
+            continue;
+        }
+
+        /* parse the subtrees */
+        lyb = chunk + strlen(chunk) + 1;
+        if ((err_info = sr_lyd_parse_data(ev_sess->conn->ly_ctx, lyb, NULL, LYD_LYB,
+                LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT | LYD_PARSE_ORDERED, 0, &tree))) {
+            return err_info;
+        }
+        if ((err_info = sr_lyd_insert_sibling(ev_sess->dt[ev_sess->ds].diff, tree, &ev_sess->dt[ev_sess->ds].diff))) {
+            lyd_free_all(tree);
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
 sr_error_info_t *
 sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_subs, sr_conn_ctx_t *conn)
 {
@@ -3417,7 +3830,6 @@ sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_sub
     char *data = NULL, *shm_data_ptr;
     int ret = SR_ERR_OK, filter_valid;
     sr_lock_mode_t sub_lock = SR_LOCK_NONE;
-    struct lyd_node *diff;
     sr_data_t *edit_data;
     sr_error_t err_code = SR_ERR_OK;
     struct modsub_changesub_s *change_sub;
@@ -3471,16 +3883,12 @@ sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_sub
         goto cleanup;
     }
 
-    /* parse event diff */
-    if ((err_info = sr_lyd_parse_data(conn->ly_ctx, shm_data_ptr, NULL, LYD_LYB,
-            LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT | LYD_PARSE_ORDERED, 0, &diff))) {
+    /* parse the needed parts of the event diff into the session */
+    if ((err_info = sr_shmsub_change_listen_parse_diff(change_subs, shm_data_ptr, ev_sess))) {
         SR_ERRINFO_INT(&err_info);
         goto cleanup;
     }
 
-    /* assign to session */
-    ev_sess->dt[ev_sess->ds].diff = diff;
-
     /* process event */
     SR_LOG_DBG("EV LISTEN: \"%s\" \"%s\" ID %" PRIu32 " priority %" PRIu32 " processing (remaining %" PRIu32 " subscribers).",
             change_subs->module_name, sr_ev2str(sub_info.event), sub_info.request_id, sub_info.priority,
@@ -3502,9 +3910,23 @@ process_event:
         sr_rwunlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, sub_lock, conn->cid, __func__);
         sub_lock = SR_LOCK_NONE;
 
-        /* call callback if there are some changes */
-        filter_valid = sr_shmsub_change_filter_is_valid(change_sub->xpath, diff);
-        if (filter_valid) {
+        if ((sub_info.event == SR_SUB_EV_DONE) && (change_sub->opts & SR_SUBSCR_MIRROR)) {
+            /* update the mirrored data with all the changes */
+            if ((err_info = sr_conn_change_mirror_update(conn, change_sub->sub_id, ev_sess->dt[ev_sess->ds].diff))) {
+                goto cleanup;
+            }
+        }
+
+        /* call callback if there are some changes (the diff may have been completely parsed by a callback) */
+        filter_valid = sr_shmsub_change_filter_is_valid(change_sub->xpath, ev_sess->dt[ev_sess->ds].diff);
+        if (filter_valid && (sub_info.event == SR_SUB_EV_DONE) && (change_sub->opts & SR_SUBSCR_DONE_COALESCE)) {
+            /* only accumulate the changes, they are delivered later */
+            if ((err_info = sr_shmsub_change_listen_coalesce(change_sub, ev_sess->dt[ev_sess->ds].diff,
+                    sub_info.request_id))) {
+                goto cleanup;
+            }
+            ret = SR_ERR_OK;
+        } else if (filter_valid) {
             ret = change_sub->cb(ev_sess, change_sub->sub_id, change_subs->module_name, change_sub->xpath,
                     sr_ev2api(sub_info.event), sub_info.request_id, change_sub->private_data);
         } else if (!(change_sub->opts & SR_SUBSCR_FILTER_ORIG)) {
@@ -3614,6 +4036,149 @@ cleanup:
     return err_info;
 }
 
+sr_error_info_t *
+sr_shmsub_change_listen_coalesced_flush(struct modsub_change_s *change_subs, struct modsub_changesub_s *change_sub,
+        sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_session_ctx_t *ev_sess = NULL;
+    struct lyd_node *diff = NULL;
+
+    if (!change_sub->coalesce_lyb) {
+        /* nothing to deliver */
+        goto cleanup;
+    }
+
+    /* parse the accumulated changes */
+    err_info = sr_lyd_parse_data(conn->ly_ctx, change_sub->coalesce_lyb, NULL, LYD_LYB,
+            LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT | LYD_PARSE_ORDERED, 0, &diff);
+    free(change_sub->coalesce_lyb);
+    change_sub->coalesce_lyb = NULL;
+    change_sub->coalesce_count = 0;
+    if (err_info) {
+        goto cleanup;
+    }
+
+    /* create event session */
+    if ((err_info = _sr_session_start(conn, change_subs->ds, SR_SUB_EV_DONE, NULL, &ev_sess))) {
+        goto cleanup;
+    }
+    ev_sess->dt[ev_sess->ds].diff = diff;
+    diff = NULL;
+
+    SR_LOG_DBG("EV LISTEN: \"%s\" \"%s\" ID %" PRIu32 " processing (coalesced).", change_subs->module_name,
+            sr_ev2str(SR_SUB_EV_DONE), change_sub->coalesce_request_id);
+
+    /* call callback, errors are ignored the same as for any done event */
+    change_sub->cb(ev_sess, change_sub->sub_id, change_subs->module_name, change_sub->xpath,
+            sr_ev2api(SR_SUB_EV_DONE), change_sub->coalesce_request_id, change_sub->private_data);
+
+cleanup:
+    lyd_free_all(diff);
+    sr_session_stop(ev_sess);
+    return err_info;
+}
+
+/**
+ * @brief Update the time to wake up in for delivering accumulated done events.
+ *
+ * @param[in] deliver_ms Milliseconds after which the events are to be delivered.
+ * @param[in,out] wake_up_in Nearest delivery of accumulated events, updated if @p deliver_ms is nearer.
+ */
+static void
+sr_shmsub_change_listen_coalesced_wake_up(uint32_t deliver_ms, struct timespec *wake_up_in)
+{
+    struct timespec deliver_in;
+
+    if (!wake_up_in) {
+        return;
+    }
+
+    deliver_in = sr_time_ts_add(NULL, deliver_ms);
+    if (SR_TS_IS_ZERO(*wake_up_in) || (sr_time_cmp(wake_up_in, &deliver_in) > 0)) {
+        *wake_up_in = deliver_in;
+    }
+}
+
+/**
+ * @brief Check whether the accumulated done events of a coalescing change subscription are to be delivered.
+ *
+ * @param[in] sub_shm Subscription SHM.
+ * @param[in] change_sub Coalescing change subscription with accumulated events.
+ * @param[in] cur_ts Current timestamp.
+ * @param[in,out] wake_up_in Nearest delivery of accumulated events, updated if the events are not to be delivered yet.
+ * @return Whether to deliver the events.
+ */
+static int
+sr_shmsub_change_listen_coalesced_is_due(sr_sub_shm_t *sub_shm, struct modsub_changesub_s *change_sub,
+        const struct timespec *cur_ts, struct timespec *wake_up_in)
+{
+    int elapsed_ms;
+
+    if (ATOMIC_LOAD_RELAXED(change_sub->suspended)) {
+        /* no new events will follow, deliver the ones accumulated before right away */
+        return 1;
+    }
+
+    if (change_sub->coalesce_ms) {
+        elapsed_ms = sr_time_sub_ms(cur_ts, &change_sub->coalesce_since);
+        if ((elapsed_ms > -1) && ((uint32_t)elapsed_ms < change_sub->coalesce_ms)) {
+            /* window not elapsed yet, wake up once it is */
+            sr_shmsub_change_listen_coalesced_wake_up(change_sub->coalesce_ms - elapsed_ms, wake_up_in);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (change_sub->coalesce_count >= SR_CHANGE_COALESCE_IDLE_MAX_COUNT) {
+        /* never idle, deliver the events accumulated so far */
+        return 1;
+    }
+
+    if (sr_shmsub_change_listen_is_new_event(sub_shm, change_sub)) {
+        /* not idle, the event pipe will wake us up again */
+        return 0;
+    }
+
+    elapsed_ms = sr_time_sub_ms(cur_ts, &change_sub->coalesce_last);
+    if ((elapsed_ms > -1) && (elapsed_ms < SR_CHANGE_COALESCE_IDLE_TIMEOUT)) {
+        /* more events may follow, wake up once idle for long enough */
+        sr_shmsub_change_listen_coalesced_wake_up(SR_CHANGE_COALESCE_IDLE_TIMEOUT - elapsed_ms, wake_up_in);
+        return 0;
+    }
+
+    return 1;
+}
+
+sr_error_info_t *
+sr_shmsub_change_listen_coalesced_deliver(struct modsub_change_s *change_subs, sr_conn_ctx_t *conn,
+        struct timespec *wake_up_in)
+{
+    sr_error_info_t *err_info = NULL;
+    struct modsub_changesub_s *change_sub;
+    struct timespec cur_ts;
+    sr_sub_shm_t *sub_shm;
+    uint32_t i;
+
+    sub_shm = (sr_sub_shm_t *)change_subs->sub_shm.addr;
+    sr_timeouttime_get(&cur_ts, 0);
+
+    for (i = 0; i < change_subs->sub_count; ++i) {
+        change_sub = &change_subs->subs[i];
+        if (!change_sub->coalesce_lyb || !sr_shmsub_change_listen_coalesced_is_due(sub_shm, change_sub, &cur_ts,
+                wake_up_in)) {
+            continue;
+        }
+
+        /* deliver the accumulated events */
+        if ((err_info = sr_shmsub_change_listen_coalesced_flush(change_subs, change_sub, conn))) {
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
 /**
  * @brief Relock oper get subscription SHM lock after it was locked before so it must be checked that no
  * unexpected changes happened in the SHM (such as this processing timed out).
@@ -4596,21 +5161,36 @@ cleanup:
 /**
  * @brief Whether a notification is valid (not filtered out) for a notif subscription.
  *
- * @param[in] input Operation input data tree.
- * @param[in] xpath Full subscription XPath.
+ * @param[in] notif Notification data tree.
+ * @param[in] notif_path Schema path of the notification, NULL if unknown.
+ * @param[in] sub Notification subscription.
  * @return 0 if not, non-zero is it is.
  */
 static int
-sr_shmsub_notif_listen_filter_is_valid(const struct lyd_node *notif, const char *xpath)
+sr_shmsub_notif_listen_filter_is_valid(const struct lyd_node *notif, const char *notif_path,
+        const struct modsub_notifsub_s *sub)
 {
     sr_error_info_t *err_info = NULL;
     ly_bool result;
+    uint32_t i;
 
-    if (!xpath) {
+    if (!sub->xpath) {
         return 1;
     }
 
-    if (lyd_eval_xpath(notif, xpath, &result)) {
+    if (notif_path && sub->notif_paths) {
+        for (i = 0; i < sub->notif_path_count; ++i) {
+            if (!strcmp(sub->notif_paths[i], notif_path)) {
+                break;
+            }
+        }
+        if (i == sub->notif_path_count) {
+            /* the XPath cannot select this notification */
+            return 0;
+        }
+    }
+
+    if (lyd_eval_xpath(notif, sub->xpath, &result)) {
         SR_ERRINFO_INT(&err_info);
         sr_errinfo_free(&err_info);
         return 0;
@@ -4630,7 +5210,7 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
     struct lyd_node *notif = NULL, *notif_op;
     struct sr_denied denied = {0};
     struct timespec notif_ts_mono, notif_ts_real;
-    char *shm_data_ptr;
+    char *shm_data_ptr, *notif_path = NULL;
     sr_sub_shm_t *sub_shm;
     sr_shm_t shm_data_sub = SR_SHM_INITIALIZER;
     sr_session_ctx_t *ev_sess = NULL;
@@ -4683,6 +5263,18 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
     /* SUB READ UNLOCK */
     sr_rwunlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
+    /* find the notification */
+    notif_op = notif;
+    if ((err_info = sr_ly_find_last_parent(&notif_op, LYS_NOTIF))) {
+        goto cleanup;
+    }
+
+    if (notif_op->schema->module->ctx == conn->ly_ctx) {
+        /* get its schema path for the subscription filters, not for mounted notifications */
+        notif_path = lysc_path(notif_op->schema, LYSC_PATH_LOG, NULL, 0);
+        SR_CHECK_MEM_GOTO(!notif_path, err_info, cleanup);
+    }
+
     /* process event */
     valid_subscr_count = 0;
     for (i = 0; i < notif_subs->sub_count; ++i) {
@@ -4712,14 +5304,8 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
             goto cleanup;
         }
 
-        /* find the notification */
-        notif_op = notif;
-        if ((err_info = sr_ly_find_last_parent(&notif_op, LYS_NOTIF))) {
-            goto cleanup;
-        }
-
         /* NACM and xpath filter */
-        if (!denied.denied && sr_shmsub_notif_listen_filter_is_valid(notif_op, sub->xpath)) {
+        if (!denied.denied && sr_shmsub_notif_listen_filter_is_valid(notif_op, notif_path, sub)) {
             /* call callback */
             if ((err_info = sr_notif_call_callback(ev_sess, sub->cb, sub->tree_cb, sub->private_data,
                     SR_EV_NOTIF_REALTIME, sub->sub_id, notif_op, &notif_ts_real))) {
@@ -4768,6 +5354,7 @@ cleanup_rdunlock:
 
 cleanup:
     free(denied.rule_name);
+    free(notif_path);
     sr_session_stop(ev_sess);
     lyd_free_all(notif);
     sr_shm_clear(&shm_data_sub);
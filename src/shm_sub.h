@@ -263,6 +263,29 @@ sr_error_info_t *sr_shmsub_listen_write_event(sr_sub_shm_t *sub_shm, uint32_t va
  */
 sr_error_info_t *sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_subs, sr_conn_ctx_t *conn);
 
+/**
+ * @brief Deliver accumulated done events of a coalescing module change subscription right away, if any.
+ *
+ * @param[in] change_subs Module change subscriptions.
+ * @param[in] change_sub Coalescing change subscription.
+ * @param[in] conn Connection to use.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_change_listen_coalesced_flush(struct modsub_change_s *change_subs,
+        struct modsub_changesub_s *change_sub, sr_conn_ctx_t *conn);
+
+/**
+ * @brief Deliver accumulated done events of coalescing module change subscriptions, if their window elapsed,
+ * they were idle for long enough, or they are suspended.
+ *
+ * @param[in] change_subs Module change subscriptions.
+ * @param[in] conn Connection to use.
+ * @param[in,out] wake_up_in Nearest delivery of accumulated events of a subscription. If none, left unmodified.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_change_listen_coalesced_deliver(struct modsub_change_s *change_subs, sr_conn_ctx_t *conn,
+        struct timespec *wake_up_in);
+
 /**
  * @brief Write into evpipe of relevant operational poll subscriptions on an operational get subscription change (added/removed).
  *
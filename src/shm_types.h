@@ -25,8 +25,9 @@
 #include "common_types.h"
 #include "sysrepo_types.h"
 
-#define SR_SHM_VER 18   /**< Main, mod, and ext SHM version of their expected content structures. */
+#define SR_SHM_VER 25   /**< Main, mod, and ext SHM version of their expected content structures. */
 #define SR_MAIN_SHM_LOCK "sr_main_lock"     /**< Main SHM file lock name. */
+#define SR_MAIN_SHM_CONN_ALIVE_COUNT 1024   /**< Number of connection alive words in main SHM. */
 
 /**
  * Main SHM organization
@@ -93,8 +94,10 @@ typedef struct {
 
     off_t in_deps;              /**< Input operation dependencies (offset in mod SHM). */
     uint16_t in_dep_count;      /**< Input dependency count. */
+    int in_data_deps;           /**< Whether input validation may need any datastore data. */
     off_t out_deps;             /**< Output operation dependencies (offset in mod SHM). */
     uint16_t out_dep_count;     /**< Output dependency count. */
+    int out_data_deps;          /**< Whether output validation may need any datastore data. */
 
     sr_rwlock_t lock;           /**< Process-shared lock for reading or preventing changes (READ) or modifying (WRITE)
                                      RPC/action subscriptions. */
@@ -132,6 +135,10 @@ typedef struct {
     char rev[11];               /**< Module revision. */
     int replay_supp;            /**< Whether module supports replay. */
     uint32_t run_cache_id;      /**< Running cached data ID. */
+    uint32_t run_replaced_id;   /**< Running data ID after the last replace of the data, valid only while it is
+                                     the current ID. */
+    uint64_t run_replaced_digest[2];    /**< Digest of the source data of the last replace of running data,
+                                             all zeros if none. Accessed with at least READ_UPGR lock. */
     off_t plugins[SR_MOD_DS_PLUGIN_COUNT];  /**< Module plugin names (offsets in mod SHM). */
 
     off_t features;             /**< Array of enabled features (off_t *) (offset in mod SHM). */
@@ -182,6 +189,7 @@ typedef struct {
  */
 typedef struct {
     uint32_t mod_count;         /**< Number of installed modules stored after this structure. */
+    uint32_t ncn_mod_idx;       /**< Index of the "ietf-netconf-notifications" module, used on every change. */
 } sr_mod_shm_t;
 
 /**
@@ -201,6 +209,12 @@ typedef struct {
     ATOMIC_T new_sr_sid;        /**< SID for a new session. */
     ATOMIC_T new_sub_id;        /**< Subscription ID of a new subscription. */
     ATOMIC_T new_evpipe_num;    /**< Event pipe number for a new subscription. */
+    ATOMIC_T sm_data_ver;       /**< Version of ietf-yang-schema-mount operational data, increased on every change. */
+
+    ATOMIC64_T conn_alive[SR_MAIN_SHM_CONN_ALIVE_COUNT];    /**< Connection alive words indexed by CID modulo their
+                                                                 count, each with the CID in the upper 32 bits and
+                                                                 the monotonic time in ms when it was last found
+                                                                 alive in the lower 32 bits. */
 
     char repo_path[256];        /**< Repository path used when main SHM was created. */
 } sr_main_shm_t;
@@ -164,3 +164,12 @@ sr_cond_broadcast(sr_cond_t *cond)
 
     sys_futex_wake(&cond->futex, INT_MAX);
 }
+
+void
+sr_cond_signal(sr_cond_t *cond)
+{
+    /* increase the counter so that a waiter about to sleep notices the "change" */
+    cond->futex++;
+
+    sys_futex_wake(&cond->futex, 1);
+}
@@ -75,4 +75,11 @@ int sr_cond_clockwait(sr_cond_t *cond, pthread_mutex_t *mutex, clockid_t clockid
  */
 void sr_cond_broadcast(sr_cond_t *cond);
 
+/**
+ * @brief Wrapper for pthread_cond_signal().
+ *
+ * @param[in] cond Condition variable to signal on.
+ */
+void sr_cond_signal(sr_cond_t *cond);
+
 #endif /* _SR_COND_FUTEX_H */
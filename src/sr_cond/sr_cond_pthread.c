@@ -87,3 +87,9 @@ sr_cond_broadcast(sr_cond_t *cond)
 {
     pthread_cond_broadcast(cond);
 }
+
+void
+sr_cond_signal(sr_cond_t *cond)
+{
+    pthread_cond_signal(cond);
+}
@@ -20,6 +20,7 @@
 #include "subscr.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -128,6 +129,7 @@ error:
 void
 sr_subscr_change_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
 {
+    sr_error_info_t *err_info = NULL;
     uint32_t i, j;
     struct modsub_change_s *change_sub;
 
@@ -139,8 +141,17 @@ sr_subscr_change_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
                 continue;
             }
 
-            /* found our subscription, replace it with the last */
+            /* found our subscription, deliver any accumulated changes */
+            if ((err_info = sr_shmsub_change_listen_coalesced_flush(change_sub, &change_sub->subs[j], subscr->conn))) {
+                sr_errinfo_free(&err_info);
+            }
+
+            /* replace it with the last */
+            if (change_sub->subs[j].opts & SR_SUBSCR_MIRROR) {
+                sr_conn_change_mirror_del(subscr->conn, sub_id);
+            }
             free(change_sub->subs[j].xpath);
+            free(change_sub->subs[j].coalesce_lyb);
             if (j < change_sub->sub_count - 1) {
                 memcpy(&change_sub->subs[j], &change_sub->subs[change_sub->sub_count - 1], sizeof *change_sub->subs);
             }
@@ -428,6 +439,107 @@ sr_subscr_oper_poll_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
     assert(0);
 }
 
+/**
+ * @brief Free notification paths of a notification subscription.
+ *
+ * @param[in] sub Notification subscription.
+ */
+static void
+sr_subscr_notif_paths_free(struct modsub_notifsub_s *sub)
+{
+    uint32_t i;
+
+    for (i = 0; i < sub->notif_path_count; ++i) {
+        free(sub->notif_paths[i]);
+    }
+    free(sub->notif_paths);
+    sub->notif_paths = NULL;
+    sub->notif_path_count = 0;
+}
+
+sr_error_info_t *
+sr_subscr_notif_paths_update(const struct ly_ctx *ly_ctx, struct modsub_notifsub_s *sub)
+{
+    sr_error_info_t *err_info = NULL;
+    struct ly_set *set = NULL;
+    const struct lysc_node *snode;
+    char *expr = NULL, *path = NULL;
+    const char *ptr;
+    uint32_t i, j;
+    int valid;
+    void *mem;
+
+    sr_subscr_notif_paths_free(sub);
+    if (!sub->xpath) {
+        /* all the notifications selected */
+        goto cleanup;
+    }
+
+    /* check the expression without predicates */
+    if ((err_info = sr_get_trim_predicates(sub->xpath, &expr))) {
+        goto cleanup;
+    }
+    for (ptr = expr; ptr[0]; ++ptr) {
+        if (((ptr == expr) || (ptr[-1] == '|')) && (ptr[0] != '/')) {
+            /* not an absolute path */
+            goto cleanup;
+        } else if ((ptr[0] == '/') && (ptr[1] == '/')) {
+            /* descendants, may select different notifications after a context change */
+            goto cleanup;
+        } else if (!isalnum(ptr[0]) && !strchr("_-.:/|", ptr[0])) {
+            /* wildcard, operator, or other non-path token */
+            goto cleanup;
+        }
+    }
+
+    /* find the selected schema nodes */
+    if ((err_info = sr_lys_find_xpath(ly_ctx, sub->xpath, 0, &valid, &set)) || !valid || !set->count) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < set->count; ++i) {
+        /* find the notification of the node */
+        for (snode = set->snodes[i]; snode && (snode->nodetype != LYS_NOTIF); snode = snode->parent) {}
+        if (!snode) {
+            /* a node that is not in a notification can be selected for any notification */
+            sr_subscr_notif_paths_free(sub);
+            goto cleanup;
+        }
+
+        path = lysc_path(snode, LYSC_PATH_LOG, NULL, 0);
+        SR_CHECK_MEM_GOTO(!path, err_info, cleanup);
+
+        for (j = 0; j < sub->notif_path_count; ++j) {
+            if (!strcmp(sub->notif_paths[j], path)) {
+                break;
+            }
+        }
+        if (j < sub->notif_path_count) {
+            /* already added */
+            free(path);
+            path = NULL;
+            continue;
+        }
+
+        /* add the path */
+        mem = realloc(sub->notif_paths, (sub->notif_path_count + 1) * sizeof *sub->notif_paths);
+        SR_CHECK_MEM_GOTO(!mem, err_info, cleanup);
+        sub->notif_paths = mem;
+        sub->notif_paths[sub->notif_path_count] = path;
+        ++sub->notif_path_count;
+        path = NULL;
+    }
+
+cleanup:
+    if (err_info) {
+        sr_subscr_notif_paths_free(sub);
+    }
+    free(expr);
+    free(path);
+    ly_set_free(set, NULL);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_subscr_notif_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_session_ctx_t *sess, const char *mod_name,
         const char *xpath, const struct timespec *listen_since_mono, const struct timespec *listen_since_real,
@@ -493,6 +605,11 @@ sr_subscr_notif_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_sessi
         mem[3] = strdup(xpath);
         SR_CHECK_MEM_GOTO(!mem[3], err_info, error);
         notif_sub->subs[notif_sub->sub_count].xpath = mem[3];
+
+        /* learn which notifications the XPath can select */
+        if ((err_info = sr_subscr_notif_paths_update(subscr->conn->ly_ctx, &notif_sub->subs[notif_sub->sub_count]))) {
+            goto error;
+        }
     }
     notif_sub->subs[notif_sub->sub_count].listen_since_mono = *listen_since_mono;
     notif_sub->subs[notif_sub->sub_count].listen_since_real = *listen_since_real;
@@ -576,6 +693,7 @@ sr_subscr_notif_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_ev_no
 
             /* replace the subscription with the last */
             free(sub->xpath);
+            sr_subscr_notif_paths_free(sub);
             if (j < notif_sub->sub_count - 1) {
                 memcpy(sub, &notif_sub->subs[notif_sub->sub_count - 1], sizeof *notif_sub->subs);
             }
@@ -45,6 +45,8 @@ sr_error_info_t *sr_subscr_change_sub_add(sr_subscription_ctx_t *subscr, uint32_
 /**
  * @brief Delete a change subscription from a subscription structure.
  *
+ * Any accumulated done events of a coalescing subscription are delivered first.
+ *
  * @param[in,out] subscr Subscription structure.
  * @param[in] sub_id Unique sub ID.
  */
@@ -330,6 +332,20 @@ sr_error_info_t *sr_subscr_oper_path_check(const struct ly_ctx *ly_ctx, const ch
  */
 sr_error_info_t *sr_subscr_notif_xpath_check(const struct lys_module *ly_mod, const char *xpath, int *valid);
 
+/**
+ * @brief Learn all the notifications the XPath of a notif subscription can select so that the XPath does not have
+ * to be evaluated for any other notifications.
+ *
+ * Only absolute location paths with predicates and their unions are supported, any other expression can be true
+ * for any notification. Wildcards and descendants are not supported either because they may select other
+ * notifications after a context change.
+ *
+ * @param[in] ly_ctx Context to use.
+ * @param[in,out] sub Notif subscription with the XPath, its previous notification paths are replaced.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_subscr_notif_paths_update(const struct ly_ctx *ly_ctx, struct modsub_notifsub_s *sub);
+
 /**
  * @brief Check the XPath of an RPC subscription.
  *
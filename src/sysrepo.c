@@ -95,42 +95,60 @@ sr_conn_new(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
     }
     conn->main_shm.fd = -1;
 
-    if ((err_info = sr_rwlock_init(&conn->mod_remap_lock, 0))) {
+    if ((err_info = sr_mutex_init(&conn->ctx_read_lock, 0))) {
         goto error5;
     }
+
+    if ((err_info = sr_rwlock_init(&conn->mod_remap_lock, 0))) {
+        goto error6;
+    }
     conn->mod_shm.fd = -1;
 
     if ((err_info = sr_rwlock_init(&conn->ext_remap_lock, 0))) {
-        goto error6;
+        goto error7;
     }
     conn->ext_shm.fd = -1;
+    conn->ext_shm.reserve_size = SR_EXT_SHM_RESERVE_SIZE;
+    conn->ext_shm.huge_pages = 1;
 
     if ((err_info = sr_ds_handle_init(&conn->ds_handles, &conn->ds_handle_count))) {
-        goto error7;
+        goto error8;
     }
     if ((err_info = sr_rwlock_init(&conn->run_cache_lock, 0))) {
-        goto error8;
+        goto error9;
     }
     if ((err_info = sr_ntf_handle_init(&conn->ntf_handles, &conn->ntf_handle_count))) {
-        goto error9;
+        goto error10;
     }
     if ((err_info = sr_rwlock_init(&conn->oper_cache_lock, 0))) {
-        goto error10;
+        goto error11;
+    }
+    if ((err_info = sr_rwlock_init(&conn->change_mirror_lock, 0))) {
+        goto error12;
+    }
+    if ((err_info = sr_rwlock_init(&conn->yanglib_cache_lock, 0))) {
+        goto error13;
     }
 
     *conn_p = conn;
     return NULL;
 
-error10:
+error13:
+    sr_rwlock_destroy(&conn->change_mirror_lock);
+error12:
+    sr_rwlock_destroy(&conn->oper_cache_lock);
+error11:
     sr_ntf_handle_free(conn->ntf_handles, conn->ntf_handle_count);
-error9:
+error10:
     sr_rwlock_destroy(&conn->run_cache_lock);
-error8:
+error9:
     sr_ds_handle_free(conn->ds_handles, conn->ds_handle_count);
-error7:
+error8:
     sr_rwlock_destroy(&conn->ext_remap_lock);
-error6:
+error7:
     sr_rwlock_destroy(&conn->mod_remap_lock);
+error6:
+    pthread_mutex_destroy(&conn->ctx_read_lock);
 error5:
     close(conn->create_lock);
 error4:
@@ -162,9 +180,11 @@ sr_conn_free(sr_conn_ctx_t *conn)
     sr_conn_ds_destroy(conn);
 
     assert(!conn->oper_caches);
+    assert(!conn->change_mirrors);
 
     /* unlocked data destroy */
     lyd_free_siblings(conn->ly_ext_data);
+    lyd_free_siblings(conn->yanglib_cache_data);
     sr_conn_run_cache_flush(conn);
     for (i = 0; i < conn->oper_cache_count; ++i) {
         lyd_free_siblings(conn->oper_caches[i].data);
@@ -179,6 +199,7 @@ sr_conn_free(sr_conn_ctx_t *conn)
         close(conn->create_lock);
     }
     sr_shm_clear(&conn->main_shm);
+    pthread_mutex_destroy(&conn->ctx_read_lock);
     sr_rwlock_destroy(&conn->mod_remap_lock);
     sr_shm_clear(&conn->mod_shm);
     sr_rwlock_destroy(&conn->ext_remap_lock);
@@ -187,6 +208,8 @@ sr_conn_free(sr_conn_ctx_t *conn)
     sr_rwlock_destroy(&conn->run_cache_lock);
     sr_ntf_handle_free(conn->ntf_handles, conn->ntf_handle_count);
     sr_rwlock_destroy(&conn->oper_cache_lock);
+    sr_rwlock_destroy(&conn->change_mirror_lock);
+    sr_rwlock_destroy(&conn->yanglib_cache_lock);
 
     free(conn);
 }
@@ -255,9 +278,6 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
         assert(!strcmp(LYD_NAME(lyd_child(sr_mods)), "content-id"));
         main_shm->content_id = ((struct lyd_node_term *)lyd_child(sr_mods))->value.uint32;
 
-        /* recover anything left in ext SHM */
-        sr_shmext_recover_sub_all(conn);
-
         /* add all the modules in lydmods data into mod SHM */
         if ((err_info = sr_shmmod_store_modules(&conn->mod_shm, sr_mods))) {
             goto cleanup_unlock;
@@ -702,6 +722,39 @@ sr_session_notif_buf_stop(sr_session_ctx_t *session)
     return err_info;
 }
 
+sr_error_info_t *
+sr_session_ev_diff_materialize(sr_session_ctx_t *session)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *tree;
+    uint32_t i, size;
+    char *chunk;
+
+    if (!session->ev_data.diff_lazy) {
+        /* nothing to parse */
+        return NULL;
+    }
+
+    for (i = 0; !sr_ev_data_get(session->ev_data.diff_lazy, i, &size, (void **)&chunk); ++i) {
+        /* skip the top-level node name */
+        chunk += strlen(chunk) + 1;
+
+        /* parse the subtrees and add them into the diff */
+        if ((err_info = sr_lyd_parse_data(session->conn->ly_ctx, chunk, NULL, LYD_LYB,
+                LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT | LYD_PARSE_ORDERED, 0, &tree))) {
+            return err_info;
+        }
+        if ((err_info = sr_lyd_insert_sibling(session->dt[session->ds].diff, tree, &session->dt[session->ds].diff))) {
+            lyd_free_all(tree);
+            return err_info;
+        }
+    }
+
+    free(session->ev_data.diff_lazy);
+    session->ev_data.diff_lazy = NULL;
+    return NULL;
+}
+
 /**
  * @brief Unlocked stop (free) a session.
  *
@@ -749,6 +802,8 @@ _sr_session_stop(sr_session_ctx_t *session)
     free(session->orig_data);
     free(session->ev_data.orig_name);
     free(session->ev_data.orig_data);
+    free(session->ev_data.diff_lazy);
+    lyd_free_siblings(session->ev_data.mirror);
     sr_errinfo_free(&session->ev_err_info);
     pthread_mutex_destroy(&session->ptr_lock);
     for (ds = 0; ds < SR_DS_COUNT; ++ds) {
@@ -2748,6 +2803,7 @@ sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
     sr_error_info_t *err_info = NULL;
     struct ly_set *set = NULL;
     struct sr_mod_info_s mod_info;
+    int simple_path;
 
     SR_CHECK_ARG_APIRET(!session || !path || !value, session, err_info);
 
@@ -2763,8 +2819,11 @@ sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
         return sr_api_ret(session, err_info);
     }
 
-    /* collect all required modules */
-    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
+    /* collect all required modules, directly if possible */
+    if ((err_info = sr_modinfo_collect_path(session->conn->ly_ctx, path, session, &mod_info, &simple_path))) {
+        goto cleanup;
+    }
+    if (!simple_path && (err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
             MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
         goto cleanup;
     }
@@ -2776,7 +2835,12 @@ sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
     }
 
     /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
+    if (simple_path) {
+        err_info = sr_modinfo_get_path(&mod_info, path, session, &set);
+    } else {
+        err_info = sr_modinfo_get_filter(&mod_info, path, session, &set);
+    }
+    if (err_info) {
         goto cleanup;
     }
 
@@ -3262,6 +3326,7 @@ sr_get_node(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
     sr_error_info_t *err_info = NULL;
     struct ly_set *set = NULL;
     struct sr_mod_info_s mod_info;
+    int simple_path;
     struct lyd_node *n;
 
     SR_CHECK_ARG_APIRET(!session || !path || !node, session, err_info);
@@ -3283,8 +3348,11 @@ sr_get_node(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
         goto cleanup;
     }
 
-    /* collect all required modules */
-    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
+    /* collect all required modules, directly if possible */
+    if ((err_info = sr_modinfo_collect_path(session->conn->ly_ctx, path, session, &mod_info, &simple_path))) {
+        goto cleanup;
+    }
+    if (!simple_path && (err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
             MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
         goto cleanup;
     }
@@ -3296,7 +3364,12 @@ sr_get_node(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
     }
 
     /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
+    if (simple_path) {
+        err_info = sr_modinfo_get_path(&mod_info, path, session, &set);
+    } else {
+        err_info = sr_modinfo_get_filter(&mod_info, path, session, &set);
+    }
+    if (err_info) {
         goto cleanup;
     }
 
@@ -4423,10 +4496,28 @@ _sr_replace_config(sr_session_ctx_t *session, const struct lys_module *ly_mod, s
         }
     }
 
-    /* add modules with dependencies into mod_info */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO,
-            session, 0, 0, 0))) {
-        goto cleanup;
+    if (session->ds == SR_DS_RUNNING) {
+        /* digest the source data before locking */
+        if ((err_info = sr_modinfo_replace_digest(&mod_info, src_config))) {
+            goto cleanup;
+        }
+
+        /* add modules with dependencies into mod_info */
+        if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE |
+                SR_MI_DATA_NO | SR_MI_PERM_NO, session, 0, 0, 0))) {
+            goto cleanup;
+        }
+
+        /* load only the data of modules that may change or are needed, checked with the modules locked */
+        if ((err_info = sr_modinfo_replace_data_load(&mod_info, session))) {
+            goto cleanup;
+        }
+    } else {
+        /* add modules with dependencies into mod_info */
+        if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE |
+                SR_MI_PERM_NO, session, 0, 0, 0))) {
+            goto cleanup;
+        }
     }
 
     /* update affected data and create corresponding diff, src_config is spent */
@@ -4819,7 +4910,7 @@ sr_change_dslock(struct sr_mod_info_s *mod_info, uint32_t sid, int lock)
         }
         ds_lock = 1;
 
-        /* it was successfully WRITE-locked, check that DS lock state is as expected */
+        /* no other session can be modifying the data, check that DS lock state is as expected */
         if (shm_lock->ds_lock_sid && lock) {
             assert(shm_lock->ds_lock_sid == sid);
             sr_errinfo_new(&err_info, SR_ERR_LOCKED, "Module \"%s\" is already locked by this session %" PRIu32 ".",
@@ -4908,6 +4999,8 @@ _sr_un_lock(sr_session_ctx_t *session, const char *module_name, int lock, uint32
     sr_error_info_t *err_info = NULL;
     struct sr_mod_info_s mod_info;
     const struct lys_module *ly_mod = NULL;
+    sr_lock_mode_t mod_lock;
+    int mi_opts;
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_CONVENTIONAL_DS(session->ds), session, err_info);
 
@@ -4937,8 +5030,17 @@ _sr_un_lock(sr_session_ctx_t *session, const char *module_name, int lock, uint32
             goto cleanup;
         }
     }
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_WRITE, SR_MI_DATA_NO | SR_MI_PERM_READ | SR_MI_PERM_STRICT,
-            session, 0, timeout_ms, 0))) {
+    if (!lock && (mod_info.ds == SR_DS_CANDIDATE)) {
+        /* candidate data will be reset so no other session may be working with them */
+        mod_lock = SR_LOCK_WRITE;
+        mi_opts = SR_MI_DATA_NO | SR_MI_PERM_READ | SR_MI_PERM_STRICT;
+    } else {
+        /* it is enough to wait for other sessions modifying the data (holding an upgradeable READ lock or a WRITE
+         * lock), readers do not need to be waited for */
+        mod_lock = SR_LOCK_READ;
+        mi_opts = SR_MI_DATA_NO | SR_MI_PERM_READ | SR_MI_PERM_STRICT | SR_MI_LOCK_UPGRADEABLE;
+    }
+    if ((err_info = sr_modinfo_consolidate(&mod_info, mod_lock, mi_opts, session, 0, timeout_ms, 0))) {
         goto cleanup;
     }
 
@@ -5140,6 +5242,12 @@ sr_subscription_process_events(sr_subscription_ctx_t *subscription, sr_session_c
         if ((err_info = sr_shmsub_change_listen_process_module_events(&subscription->change_subs[i], subscription->conn))) {
             goto cleanup_unlock;
         }
+
+        /* deliver any accumulated done events */
+        if ((err_info = sr_shmsub_change_listen_coalesced_deliver(&subscription->change_subs[i], subscription->conn,
+                wake_up_in))) {
+            goto cleanup_unlock;
+        }
     }
 
     /* operational get subscriptions */
@@ -5303,6 +5411,20 @@ _sr_subscription_suspend_change(sr_subscription_ctx_t *subscription, uint32_t su
         }
         /* mark this as suspended in the subscription context as well to prevent stealing events */
         ATOMIC_STORE_RELAXED(change_sub->suspended, suspend);
+
+        if (suspend && (change_sub->opts & SR_SUBSCR_DONE_COALESCE)) {
+            /* wake up the listener to deliver any accumulated events */
+            if ((err_info = sr_shmsub_notify_evpipe(subscription->evpipe_num))) {
+                goto cleanup;
+            }
+        }
+
+        if (suspend && (change_sub->opts & SR_SUBSCR_MIRROR)) {
+            /* changes will be missed, discard the mirrored data */
+            if ((err_info = sr_conn_change_mirror_update(subscription->conn, sub_id, NULL))) {
+                goto cleanup;
+            }
+        }
     } else if ((oper_get_sub = sr_subscr_oper_get_sub_find(subscription, sub_id, &module_name))) {
         /* oper get sub */
         if ((err_info = sr_shmext_oper_get_sub_suspended(subscription->conn, module_name, sub_id, suspend, NULL))) {
@@ -5829,13 +5951,15 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, c
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_STANDARD_DS(session->ds) || SR_IS_EVENT_SESS(session) || !module_name ||
             !callback || !subscription, session, err_info);
+    SR_CHECK_ARG_APIRET((opts & SR_SUBSCR_MIRROR) && (!SR_IS_CONVENTIONAL_DS(session->ds) ||
+            (opts & SR_SUBSCR_FILTER_ORIG)), session, err_info);
 
     SR_MODINFO_INIT(mod_info, session->conn, SR_DS_RUNNING, SR_DS_RUNNING);
 
     conn = session->conn;
     /* only these options are relevant outside this function and will be stored */
     sub_opts = opts & (SR_SUBSCR_DONE_ONLY | SR_SUBSCR_PASSIVE | SR_SUBSCR_UPDATE | SR_SUBSCR_FILTER_ORIG |
-            SR_SUBSCR_CHANGE_ALL_MODULES);
+            SR_SUBSCR_CHANGE_ALL_MODULES | SR_SUBSCR_DONE_COALESCE | SR_SUBSCR_MIRROR);
 
     /* CONTEXT LOCK */
     if ((err_info = sr_lycc_lock(conn, SR_LOCK_READ, 0, __func__))) {
@@ -5911,6 +6035,12 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, c
         goto error1;
     }
 
+    /* load the mirrored data, no changes can be made until the subscription is added */
+    if ((opts & SR_SUBSCR_MIRROR) && (err_info = sr_conn_change_mirror_add(conn, sub_id, ly_mod, xpath,
+            session->ds, (opts & SR_SUBSCR_ENABLED) ? 1 : 0))) {
+        goto error2;
+    }
+
     /* add the subscription into session */
     if ((err_info = sr_ptr_add(&session->ptr_lock, (void ***)&session->subscriptions, &session->subscription_count,
             *subscription))) {
@@ -6046,6 +6176,44 @@ cleanup_unlock:
     return sr_api_ret(NULL, err_info);
 }
 
+API int
+sr_module_change_sub_modify_coalesce(sr_subscription_ctx_t *subscription, uint32_t sub_id, uint32_t window_ms)
+{
+    sr_error_info_t *err_info = NULL;
+    struct modsub_changesub_s *change_sub;
+
+    SR_CHECK_ARG_APIRET(!subscription || !sub_id, NULL, err_info);
+
+    /* SUBS WRITE LOCK */
+    if ((err_info = sr_rwlock(&subscription->subs_lock, SR_SUBSCR_LOCK_TIMEOUT, SR_LOCK_WRITE, subscription->conn->cid,
+            __func__, NULL, NULL))) {
+        return sr_api_ret(NULL, err_info);
+    }
+
+    /* find the subscription in the subscription context */
+    change_sub = sr_subscr_change_sub_find(subscription, sub_id, NULL, NULL);
+    if (!change_sub) {
+        sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Change subscription with ID \"%" PRIu32 "\" not found.", sub_id);
+        goto cleanup_unlock;
+    } else if (!(change_sub->opts & SR_SUBSCR_DONE_COALESCE)) {
+        sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Change subscription with ID \"%" PRIu32 "\" does not coalesce "
+                "done events.", sub_id);
+        goto cleanup_unlock;
+    }
+
+    /* update the window */
+    change_sub->coalesce_ms = window_ms;
+
+    /* wake up the listener to check the accumulated events against the new window */
+    err_info = sr_shmsub_notify_evpipe(subscription->evpipe_num);
+
+cleanup_unlock:
+    /* SUBS WRITE UNLOCK */
+    sr_rwunlock(&subscription->subs_lock, SR_SUBSCR_LOCK_TIMEOUT, SR_LOCK_WRITE, subscription->conn->cid, __func__);
+
+    return sr_api_ret(NULL, err_info);
+}
+
 static int
 _sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, int dup, sr_change_iter_t **iter)
 {
@@ -6053,6 +6221,11 @@ _sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, int dup, sr_c
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_EVENT_SESS(session) || !xpath || !iter, session, err_info);
 
+    /* the XPath may select any changes */
+    if ((err_info = sr_session_ev_diff_materialize(session))) {
+        return sr_api_ret(session, err_info);
+    }
+
     if ((session->ev != SR_SUB_EV_ENABLED) && (session->ev != SR_SUB_EV_DONE) && !session->dt[session->ds].diff) {
         sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Session without changes.");
         return sr_api_ret(session, err_info);
@@ -6100,6 +6273,60 @@ sr_dup_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter
     return _sr_get_changes_iter(session, xpath, 1, iter);
 }
 
+API int
+sr_get_changes_iter_schema(sr_session_ctx_t *session, const struct lysc_node **snodes, uint32_t snode_count,
+        sr_change_iter_t **iters)
+{
+    sr_error_info_t *err_info = NULL;
+    struct ly_set **sets = NULL;
+    uint32_t i;
+
+    SR_CHECK_ARG_APIRET(!session || !SR_IS_EVENT_SESS(session) || !snodes || !snode_count || !iters, session, err_info);
+
+    if ((err_info = sr_session_ev_diff_materialize(session))) {
+        return sr_api_ret(session, err_info);
+    }
+
+    if ((session->ev != SR_SUB_EV_ENABLED) && (session->ev != SR_SUB_EV_DONE) && !session->dt[session->ds].diff) {
+        sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Session without changes.");
+        return sr_api_ret(session, err_info);
+    }
+
+    memset(iters, 0, snode_count * sizeof *iters);
+
+    sets = calloc(snode_count, sizeof *sets);
+    SR_CHECK_MEM_GOTO(!sets, err_info, cleanup);
+
+    /* group the changes by the schema nodes in a single diff traversal */
+    if ((err_info = sr_diff_snodes_collect(session->dt[session->ds].diff, snodes, snode_count, sets))) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < snode_count; ++i) {
+        iters[i] = calloc(1, sizeof **iters);
+        SR_CHECK_MEM_GOTO(!iters[i], err_info, cleanup);
+
+        /* the iterator takes over the set */
+        iters[i]->set = sets[i];
+        sets[i] = NULL;
+    }
+
+cleanup:
+    if (sets) {
+        for (i = 0; i < snode_count; ++i) {
+            ly_set_free(sets[i], NULL);
+        }
+        free(sets);
+    }
+    if (err_info) {
+        for (i = 0; i < snode_count; ++i) {
+            sr_free_change_iter(iters[i]);
+            iters[i] = NULL;
+        }
+    }
+    return sr_api_ret(session, err_info);
+}
+
 /**
  * @brief Transform change from a libyang node tree into sysrepo value.
  *
@@ -6401,13 +6628,45 @@ sr_free_change_iter(sr_change_iter_t *iter)
 API const struct lyd_node *
 sr_get_change_diff(sr_session_ctx_t *session)
 {
+    sr_error_info_t *err_info = NULL;
+
     if (!session || !SR_IS_EVENT_SESS(session)) {
         return NULL;
     }
 
+    /* the whole diff is returned */
+    if ((err_info = sr_session_ev_diff_materialize(session))) {
+        sr_api_ret(session, err_info);
+        return NULL;
+    }
+
     return session->dt[session->ds].diff;
 }
 
+API int
+sr_get_change_mirror(sr_session_ctx_t *session, uint32_t sub_id, const struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !SR_IS_EVENT_SESS(session) || !sub_id || !data, session, err_info);
+
+    *data = NULL;
+
+    if (session->ev_data.mirror_sub_id != sub_id) {
+        /* copy the current mirror data, they are owned by the event session for the whole callback */
+        lyd_free_siblings(session->ev_data.mirror);
+        session->ev_data.mirror = NULL;
+        session->ev_data.mirror_sub_id = 0;
+        if ((err_info = sr_conn_change_mirror_get(session->conn, sub_id, &session->ev_data.mirror))) {
+            return sr_api_ret(session, err_info);
+        }
+        session->ev_data.mirror_sub_id = sub_id;
+    }
+
+    *data = session->ev_data.mirror;
+    return sr_api_ret(session, err_info);
+}
+
 /**
  * @brief Subscribe to an RPC/action.
  *
@@ -6747,16 +7006,21 @@ _sr_rpc_send_tree(sr_session_ctx_t *session, struct sr_mod_info_s *mod_info, con
         goto cleanup;
     }
 
-    /* collect all required modules for input validation */
-    if ((err_info = sr_shmmod_get_rpc_deps(SR_CONN_MOD_SHM(session->conn), path, 0, &shm_deps, &shm_dep_count))) {
-        goto cleanup;
-    }
-    if ((err_info = sr_shmmod_collect_deps(SR_CONN_MOD_SHM(session->conn), shm_deps, shm_dep_count, input, mod_info))) {
-        goto cleanup;
-    }
-    if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_NEW_DEPS | SR_MI_DATA_RO | SR_MI_PERM_NO,
-            session, SR_OPER_CB_TIMEOUT, 0, 0))) {
-        goto cleanup;
+    /* find the RPC */
+    shm_rpc = sr_shmmod_find_rpc(SR_CONN_MOD_SHM(session->conn), path);
+    SR_CHECK_INT_GOTO(!shm_rpc, err_info, cleanup);
+
+    if (shm_rpc->in_data_deps) {
+        /* collect all required modules for input validation */
+        sr_shmmod_get_rpc_deps(SR_CONN_MOD_SHM(session->conn), shm_rpc, 0, &shm_deps, &shm_dep_count);
+        if ((err_info = sr_shmmod_collect_deps(SR_CONN_MOD_SHM(session->conn), shm_deps, shm_dep_count, input,
+                mod_info))) {
+            goto cleanup;
+        }
+        if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_NEW_DEPS | SR_MI_DATA_RO | SR_MI_PERM_NO,
+                session, SR_OPER_CB_TIMEOUT, 0, 0))) {
+            goto cleanup;
+        }
     }
 
     /* validate the operation, must be valid only at the time of execution */
@@ -6777,10 +7041,6 @@ _sr_rpc_send_tree(sr_session_ctx_t *session, struct sr_mod_info_s *mod_info, con
         }
     }
 
-    /* find the RPC */
-    shm_rpc = sr_shmmod_find_rpc(SR_CONN_MOD_SHM(session->conn), path);
-    SR_CHECK_INT_GOTO(!shm_rpc, err_info, cleanup);
-
     /* RPC SUB READ LOCK */
     if ((err_info = sr_rwlock(&shm_rpc->lock, SR_SHMEXT_SUB_LOCK_TIMEOUT, SR_LOCK_READ, session->conn->cid, __func__,
             NULL, NULL))) {
@@ -6808,16 +7068,17 @@ _sr_rpc_send_tree(sr_session_ctx_t *session, struct sr_mod_info_s *mod_info, con
         goto cleanup;
     }
 
-    /* collect all required modules for output validation */
-    if ((err_info = sr_shmmod_get_rpc_deps(SR_CONN_MOD_SHM(session->conn), path, 1, &shm_deps, &shm_dep_count))) {
-        goto cleanup;
-    }
-    if ((err_info = sr_shmmod_collect_deps(SR_CONN_MOD_SHM(session->conn), shm_deps, shm_dep_count, input, mod_info))) {
-        goto cleanup;
-    }
-    if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_NEW_DEPS | SR_MI_DATA_RO | SR_MI_PERM_NO,
-            session, SR_OPER_CB_TIMEOUT, 0, 0))) {
-        goto cleanup;
+    if (shm_rpc->out_data_deps) {
+        /* collect all required modules for output validation */
+        sr_shmmod_get_rpc_deps(SR_CONN_MOD_SHM(session->conn), shm_rpc, 1, &shm_deps, &shm_dep_count);
+        if ((err_info = sr_shmmod_collect_deps(SR_CONN_MOD_SHM(session->conn), shm_deps, shm_dep_count, input,
+                mod_info))) {
+            goto cleanup;
+        }
+        if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_NEW_DEPS | SR_MI_DATA_RO | SR_MI_PERM_NO,
+                session, SR_OPER_CB_TIMEOUT, 0, 0))) {
+            goto cleanup;
+        }
     }
 
     /* validate the output */
@@ -7511,6 +7772,9 @@ sr_notif_sub_modify_xpath(sr_subscription_ctx_t *subscription, uint32_t sub_id,
         notif_sub->xpath = strdup(xpath);
         SR_CHECK_MEM_GOTO(!notif_sub->xpath, err_info, cleanup_unlock);
     }
+    if ((err_info = sr_subscr_notif_paths_update(subscription->conn->ly_ctx, notif_sub))) {
+        goto cleanup_unlock;
+    }
 
     /* create event session */
     if ((err_info = _sr_session_start(subscription->conn, SR_DS_OPERATIONAL, SR_SUB_EV_NOTIF, NULL, &ev_sess))) {
@@ -1448,6 +1448,21 @@ int sr_module_change_sub_get_info(sr_subscription_ctx_t *subscription, uint32_t
  */
 int sr_module_change_sub_modify_xpath(sr_subscription_ctx_t *subscription, uint32_t sub_id, const char *xpath);
 
+/**
+ * @brief Modify an existing change subscription created with ::SR_SUBSCR_DONE_COALESCE by changing the time window
+ * in which ::SR_EV_DONE events are accumulated before they are delivered.
+ *
+ * The events accumulated so far are checked against the new window right away so setting it to 0 delivers them
+ * once there are no new events for a short while.
+ *
+ * @param[in] subscription Subscription structure to use.
+ * @param[in] sub_id Subscription ID of the specific subscription to modify.
+ * @param[in] window_ms Window in milliseconds starting with the first accumulated event, 0 to deliver the events
+ * once there are no new events for a short while (default).
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_module_change_sub_modify_coalesce(sr_subscription_ctx_t *subscription, uint32_t sub_id, uint32_t window_ms);
+
 /**
  * @brief Create an iterator for retrieving the changes (list of newly added / removed / modified nodes)
  * in module-change callbacks. It __cannot__ be used outside the callback.
@@ -1482,6 +1497,26 @@ int sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_
  */
 int sr_dup_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter);
 
+/**
+ * @brief Create iterators for retrieving the changes grouped by schema nodes in module-change callbacks.
+ * It __cannot__ be used outside the callback.
+ *
+ * The diff is traversed only once for all the schema nodes, which is much faster than calling ::sr_get_changes_iter
+ * for each of them when handling several parts of a large changeset. Each iterator returns the changes of all
+ * the instances of its schema node including all their descendants, as if selected by `<schema-path>//.`.
+ *
+ * @see ::sr_get_change_next for iterating over the changeset using these iterators.
+ *
+ * @param[in] session Implicit session provided in the callbacks (::sr_module_change_cb). Will not work with other sessions.
+ * @param[in] snodes Array of schema nodes to get the changes of, from the context of @p session.
+ * @param[in] snode_count Count of @p snodes.
+ * @param[out] iters Array of @p snode_count iterators, filled with an iterator for each schema node in the same order.
+ * Each should be freed with ::sr_free_change_iter.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_changes_iter_schema(sr_session_ctx_t *session, const struct lysc_node **snodes, uint32_t snode_count,
+        sr_change_iter_t **iters);
+
 /**
  * @brief Return the next change from the provided iterator created
  * by ::sr_get_changes_iter call. Data are represented as ::sr_val_t structures.
@@ -1544,6 +1579,21 @@ void sr_free_change_iter(sr_change_iter_t *iter);
  */
 const struct lyd_node *sr_get_change_diff(sr_session_ctx_t *session);
 
+/**
+ * @brief Get the mirrored data of a change subscription created with ::SR_SUBSCR_MIRROR in module-change callbacks.
+ * It __cannot__ be used outside the callback.
+ *
+ * The data are a copy of the current data selected by the subscription XPath, or of the whole module if there is
+ * none, made on the first call in a callback. In ::SR_EV_CHANGE and ::SR_EV_UPDATE events, they do not include
+ * the changes of the event yet, in ::SR_EV_DONE events they do.
+ *
+ * @param[in] session Implicit session provided in the callbacks (::sr_module_change_cb). Will not work with other sessions.
+ * @param[in] sub_id Subscription ID provided in the callback.
+ * @param[out] data Const mirrored data tree, must not be modified and is valid only in the callback.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_change_mirror(sr_session_ctx_t *session, uint32_t sub_id, const struct lyd_node **data);
+
 /** @} datasubs */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1855,6 +1905,15 @@ int sr_oper_poll_subscribe(sr_session_ctx_t *session, const char *module_name, c
  */
 #define SRP_CLEANUP_CB  "sr_plugin_cleanup_cb"
 
+/**
+ * @brief sysrepo-plugind plugin initialization dependencies variable name that may optionally exist in a plugin.
+ *
+ * The variable must be a NULL-terminated array of strings (`const char *sr_plugin_init_deps[]`) with the names
+ * of the plugins that must be initialized before this plugin. It is relevant only if plugins are initialized
+ * in parallel, plugins not loaded by sysrepo-plugind are ignored.
+ */
+#define SRP_INIT_DEPS   "sr_plugin_init_deps"
+
 /**
  * @brief Log a plugin error message and add the error into an error info structure.
  *
@@ -461,7 +461,26 @@ typedef enum {
      * than the one the callback subscribed for, use this flag. Normally, only the changes of the subscribed module
      * are sent to the callback so it retrieves the old data of other modules.
      */
-    SR_SUBSCR_CHANGE_ALL_MODULES = 0x0200
+    SR_SUBSCR_CHANGE_ALL_MODULES = 0x0200,
+
+    /**
+     * @brief Do not call the callback for every ::SR_EV_DONE event but accumulate the changes and deliver them merged
+     * in a single ::SR_EV_DONE event. By default, the changes are delivered once the subscription has had no new events
+     * for a short while or after many accumulated events. A time window in which the changes are accumulated can be set
+     * by ::sr_module_change_sub_modify_coalesce(). Accumulated changes are also delivered when the subscription is
+     * suspended or removed. The delivered event has no originator information and its request ID is the ID of the last
+     * accumulated request. Accepted only for ::sr_module_change_subscribe().
+     */
+    SR_SUBSCR_DONE_COALESCE = 0x0400,
+
+    /**
+     * @brief Keep an up-to-date copy of the subscribed module data in the connection. The data are loaded once when
+     * subscribing and then updated with the changes of every ::SR_EV_DONE event before the callback is called. The
+     * part selected by the subscription XPath can be accessed read-only in the callbacks using ::sr_get_change_mirror()
+     * instead of getting the current data from the datastore. Accepted only for ::sr_module_change_subscribe() of a conventional datastore and cannot be
+     * combined with ::SR_SUBSCR_FILTER_ORIG.
+     */
+    SR_SUBSCR_MIRROR = 0x0800
 
 } sr_subscr_flag_t;
 
@@ -514,6 +514,28 @@ test_get_item(struct test_state *state, struct timespec *ts_start, struct timesp
     return SR_ERR_OK;
 }
 
+static int
+test_get_item_hash(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    int r;
+    sr_val_t *val;
+    char path[64];
+
+    sprintf(path, "/perf:cont/lst[k1='%" PRIu32 "'][k2='str%" PRIu32 "']/l", state->count / 2, state->count / 2);
+
+    TEST_START(ts_start);
+
+    if ((r = sr_get_item(state->sess, path, 0, &val))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    sr_free_val(val);
+
+    return SR_ERR_OK;
+}
+
 static int
 test_get_tree_hash(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -919,6 +941,8 @@ sysrepo_destroy(void)
 struct test tests[] = {
     {"get tree", setup_running, test_get_tree, teardown_running},
     {"get item", setup_running, test_get_item, teardown_running},
+    {"get item hash", setup_running, test_get_item_hash, teardown_running},
+    {"get item hash cached", setup_running_cached, test_get_item_hash, teardown_running},
     {"get tree hash", setup_running, test_get_tree_hash, teardown_running},
     {"get tree hash cached", setup_running_cached, test_get_tree_hash, teardown_running},
     {"get user ordered tree", setup_userordered_running, test_get_user_order_tree, teardown_running},
@@ -8094,6 +8094,455 @@ test_diff_reuse(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+/* TEST */
+struct coalesce_state {
+    ATOMIC_T cb_called;
+    struct lyd_node *diff[2];
+};
+
+static int
+module_done_coalesce_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct coalesce_state *cst = (struct coalesce_state *)private_data;
+    uint32_t idx;
+
+    (void)sub_id;
+    (void)xpath;
+    (void)request_id;
+
+    assert_string_equal(module_name, "test");
+    assert_int_equal(event, SR_EV_DONE);
+
+    /* keep the delivered diff to be checked */
+    idx = ATOMIC_LOAD_RELAXED(cst->cb_called);
+    if (idx < 2) {
+        assert_int_equal(LY_SUCCESS, lyd_dup_siblings(sr_get_change_diff(session), NULL, LYD_DUP_RECURSIVE,
+                &cst->diff[idx]));
+    }
+
+    ATOMIC_INC_RELAXED(cst->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_done_coalesce(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct coalesce_state cst = {0};
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess;
+    struct lyd_meta *meta;
+    const char *values[] = {"1", "2", "3"};
+    uint32_t sub_id;
+    int ret, i;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "test", NULL, module_done_coalesce_cb, &cst, 0,
+            SR_SUBSCR_DONE_ONLY | SR_SUBSCR_DONE_COALESCE, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    sub_id = sr_subscription_get_last_sub_id(subscr);
+
+    /* accumulate changes for a window that cannot elapse during the test */
+    ret = sr_module_change_sub_modify_coalesce(subscr, sub_id, 3600000);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* several commits */
+    for (i = 0; i < 3; ++i) {
+        ret = sr_set_item_str(sess, "/test:test-leaf", values[i], NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    /* nothing delivered yet */
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 0);
+
+    /* flush the accumulated changes */
+    ret = sr_module_change_sub_modify_coalesce(subscr, sub_id, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* wait for the single merged event */
+    for (i = 0; (i < 100) && !ATOMIC_LOAD_RELAXED(cst.cb_called); ++i) {
+        usleep(100000);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 1);
+
+    /* all the changes merged into one creation */
+    assert_non_null(cst.diff[0]);
+    assert_null(cst.diff[0]->next);
+    assert_string_equal(cst.diff[0]->schema->name, "test-leaf");
+    assert_string_equal(lyd_get_value(cst.diff[0]), "3");
+    meta = lyd_find_meta(cst.diff[0]->meta, NULL, "yang:operation");
+    assert_non_null(meta);
+    assert_string_equal(lyd_get_meta_value(meta), "create");
+
+    /* delivered once idle */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    for (i = 0; (i < 100) && (ATOMIC_LOAD_RELAXED(cst.cb_called) < 2); ++i) {
+        usleep(100000);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 2);
+
+    assert_non_null(cst.diff[1]);
+    assert_null(cst.diff[1]->next);
+    assert_string_equal(cst.diff[1]->schema->name, "test-leaf");
+    meta = lyd_find_meta(cst.diff[1]->meta, NULL, "yang:operation");
+    assert_non_null(meta);
+    assert_string_equal(lyd_get_meta_value(meta), "delete");
+
+    /* delivered when suspended */
+    ret = sr_module_change_sub_modify_coalesce(subscr, sub_id, 3600000);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "4", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 2);
+
+    ret = sr_subscription_suspend(subscr, sub_id);
+    assert_int_equal(ret, SR_ERR_OK);
+    for (i = 0; (i < 100) && (ATOMIC_LOAD_RELAXED(cst.cb_called) < 3); ++i) {
+        usleep(100000);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 3);
+    ret = sr_subscription_resume(subscr, sub_id);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* delivered when unsubscribed */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 3);
+
+    /* not a coalescing subscription */
+    ret = sr_module_change_subscribe(sess, "test", NULL, module_done_coalesce_cb, &cst, 0, SR_SUBSCR_DONE_ONLY,
+            &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_module_change_sub_modify_coalesce(subscr, sr_subscription_get_last_sub_id(subscr), 0);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    ret = sr_unsubscribe(subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(cst.cb_called), 4);
+
+    sr_session_stop(sess);
+    for (i = 0; i < 2; ++i) {
+        lyd_free_siblings(cst.diff[i]);
+    }
+}
+
+/* TEST */
+static int
+module_change_schema_iter_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    const struct ly_ctx *ly_ctx;
+    const struct lysc_node *snodes[3];
+    sr_change_iter_t *iters[3];
+    sr_change_oper_t op;
+    const struct lyd_node *node;
+    uint32_t i, count;
+    int ret;
+
+    (void)sub_id;
+    (void)xpath;
+    (void)request_id;
+
+    assert_string_equal(module_name, "ietf-interfaces");
+    if (event != SR_EV_CHANGE) {
+        return SR_ERR_OK;
+    }
+
+    ly_ctx = sr_session_acquire_context(session);
+    snodes[0] = lys_find_path(ly_ctx, NULL, "/ietf-interfaces:interfaces/interface", 0);
+    snodes[1] = lys_find_path(ly_ctx, NULL, "/ietf-interfaces:interfaces/interface/description", 0);
+    snodes[2] = lys_find_path(ly_ctx, NULL, "/ietf-interfaces:interfaces-state", 0);
+    assert_non_null(snodes[0]);
+    assert_non_null(snodes[1]);
+    assert_non_null(snodes[2]);
+
+    ret = sr_get_changes_iter_schema(session, snodes, 3, iters);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* whole interface subtree - interface, name, type, enabled, description */
+    count = 0;
+    while (!(ret = sr_get_change_tree_next(session, iters[0], &op, &node, NULL, NULL, NULL))) {
+        assert_int_equal(op, SR_OP_CREATED);
+        if (!count) {
+            assert_string_equal(node->schema->name, "interface");
+        }
+        ++count;
+    }
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    assert_int_equal(count, 5);
+
+    /* only the description */
+    ret = sr_get_change_tree_next(session, iters[1], &op, &node, NULL, NULL, NULL);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(op, SR_OP_CREATED);
+    assert_string_equal(node->schema->name, "description");
+    assert_string_equal(lyd_get_value(node), "desc");
+    ret = sr_get_change_tree_next(session, iters[1], &op, &node, NULL, NULL, NULL);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+
+    /* no state data changes */
+    ret = sr_get_change_tree_next(session, iters[2], &op, &node, NULL, NULL, NULL);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+
+    for (i = 0; i < 3; ++i) {
+        sr_free_change_iter(iters[i]);
+    }
+    sr_session_release_context(session);
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_change_schema_iter(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "ietf-interfaces", NULL, module_change_schema_iter_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces/interface[name='eth52']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces/interface[name='eth52']/description", "desc", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    sr_unsubscribe(subscr);
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/ietf-interfaces:interfaces", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static int
+module_change_lazy_diff_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    const struct lyd_node *diff, *node;
+    sr_change_iter_t *iter;
+    sr_change_oper_t op;
+    uint32_t count;
+    int ret;
+
+    (void)sub_id;
+    (void)request_id;
+
+    assert_string_equal(module_name, "test");
+    assert_string_equal(xpath, "/test:test-leaf");
+    if (event != SR_EV_CHANGE) {
+        return SR_ERR_OK;
+    }
+
+    /* changes outside the subscription are available as well */
+    ret = sr_get_changes_iter(session, "/test:ll1", &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    count = 0;
+    while (!(ret = sr_get_change_tree_next(session, iter, &op, &node, NULL, NULL, NULL))) {
+        assert_int_equal(op, SR_OP_CREATED);
+        ++count;
+    }
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    assert_int_equal(count, 2);
+    sr_free_change_iter(iter);
+
+    /* full diff */
+    diff = sr_get_change_diff(session);
+    count = 0;
+    LY_LIST_FOR(diff, node) {
+        ++count;
+    }
+    assert_int_equal(count, 3);
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_change_lazy_diff(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "test", "/test:test-leaf", module_change_lazy_diff_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change the subscribed leaf and other top-level nodes */
+    ret = sr_set_item_str(sess, "/test:test-leaf", "5", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:ll1", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:ll1", "2", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* only other top-level nodes changed, callback not called */
+    ret = sr_set_item_str(sess, "/test:ll1", "3", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    sr_unsubscribe(subscr);
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:ll1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static int
+module_change_mirror_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    const struct lyd_node *data, *data2, *node;
+    uint32_t count;
+    int ret;
+
+    (void)module_name;
+    (void)xpath;
+    (void)request_id;
+
+    ret = sr_get_change_mirror(session, sub_id, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* the same data for the whole callback */
+    ret = sr_get_change_mirror(session, sub_id, &data2);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_ptr_equal(data, data2);
+
+    /* count the leaf-list instances, only they are subscribed to */
+    count = 0;
+    LY_LIST_FOR(data, node) {
+        assert_string_equal(node->schema->name, "ll1");
+        ++count;
+    }
+
+    switch (ATOMIC_LOAD_RELAXED(st->cb_called)) {
+    case 0:
+        /* changes not yet applied */
+        assert_int_equal(event, SR_EV_CHANGE);
+        assert_int_equal(count, 1);
+        break;
+    case 1:
+        /* updated */
+        assert_int_equal(event, SR_EV_DONE);
+        assert_int_equal(count, 3);
+        break;
+    case 2:
+        assert_int_equal(event, SR_EV_CHANGE);
+        assert_int_equal(count, 3);
+        break;
+    case 3:
+        assert_int_equal(event, SR_EV_DONE);
+        assert_int_equal(count, 0);
+        break;
+    default:
+        fail();
+    }
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_change_mirror(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* some initial data */
+    ret = sr_set_item_str(sess, "/test:ll1", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* invalid options */
+    ret = sr_module_change_subscribe(sess, "test", "/test:ll1", module_change_mirror_cb, st, 0,
+            SR_SUBSCR_MIRROR | SR_SUBSCR_FILTER_ORIG, &subscr);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    ret = sr_module_change_subscribe(sess, "test", "/test:ll1", module_change_mirror_cb, st, 0, SR_SUBSCR_MIRROR,
+            &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* create */
+    ret = sr_set_item_str(sess, "/test:ll1", "2", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:ll1", "3", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    /* delete */
+    ret = sr_delete_item(sess, "/test:ll1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 4);
+
+    sr_unsubscribe(subscr);
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_session_stop(sess);
+}
+
 /* MAIN */
 int
 main(void)
@@ -8128,6 +8577,10 @@ main(void)
         cmocka_unit_test_setup_teardown(test_mult_update, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_done_timeout_priority, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_list_replace, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_done_coalesce, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_change_schema_iter, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_change_lazy_diff, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_change_mirror, setup_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
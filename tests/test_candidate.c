@@ -340,6 +340,60 @@ test_when(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_defaults(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_data_t *data;
+    int ret;
+
+    ret = sr_session_switch_ds(st->sess, SR_DS_CANDIDATE);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* create a list instance, its default nodes are added */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/type",
+            "iana-if-type:ethernetCsmacd", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_node(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/enabled", 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_true(data->tree->flags & LYD_DEFAULT);
+    assert_string_equal(lyd_get_value(data->tree), "true");
+    sr_release_data(data);
+
+    /* set the leaf explicitly */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/enabled", "false", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_node(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/enabled", 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_false(data->tree->flags & LYD_DEFAULT);
+    assert_string_equal(lyd_get_value(data->tree), "false");
+    sr_release_data(data);
+
+    /* delete it, the default node is added back */
+    ret = sr_delete_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/enabled", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_node(st->sess, "/ietf-interfaces:interfaces/interface[name='eth8']/enabled", 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_true(data->tree->flags & LYD_DEFAULT);
+    assert_string_equal(lyd_get_value(data->tree), "true");
+    sr_release_data(data);
+
+    /* reset candidate */
+    ret = sr_copy_config(st->sess, NULL, SR_DS_RUNNING, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_switch_ds(st->sess, SR_DS_RUNNING);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 static void
 test_reset_unlock(void **state)
 {
@@ -486,6 +540,7 @@ main(void)
         cmocka_unit_test_teardown(test_basic, clear_interfaces),
         cmocka_unit_test_teardown(test_invalid, clear_interfaces),
         cmocka_unit_test(test_when),
+        cmocka_unit_test(test_defaults),
         cmocka_unit_test(test_reset_unlock),
         cmocka_unit_test(test_reset_session_stop),
     };
@@ -20,8 +20,10 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -2415,6 +2417,256 @@ test_replace_when(void **state)
     pthread_join(tid[1], NULL);
 }
 
+/* TEST */
+static int
+module_replace_unchanged_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+
+    (void)session;
+    (void)sub_id;
+    (void)request_id;
+
+    assert_string_equal(module_name, "ietf-interfaces");
+    assert_null(xpath);
+
+    /* "done" event is not waited for */
+    if (event == SR_EV_CHANGE) {
+        ATOMIC_INC_RELAXED(st->cb_called);
+    }
+    return SR_ERR_OK;
+}
+
+static void
+test_replace_unchanged(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *subscr = NULL;
+    struct lyd_node *config, *dup;
+    sr_data_t *data;
+    char *str1;
+    const char *str2;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "ietf-interfaces", NULL, module_replace_unchanged_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* prepare some ietf-interfaces config */
+    str2 =
+            "<interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">"
+            "  <interface>"
+            "    <name>eth1</name>"
+            "    <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>"
+            "  </interface>"
+            "</interfaces>";
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(st->ly_ctx, str2, LYD_XML,
+            LYD_PARSE_STRICT, LYD_VALIDATE_NO_STATE | LYD_VALIDATE_PRESENT, &config));
+
+    /* replace the whole config */
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(config, NULL, LYD_DUP_RECURSIVE, &dup));
+    ret = sr_replace_config(sess, NULL, dup, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* replace it again with the same config, no changes */
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(config, NULL, LYD_DUP_RECURSIVE, &dup));
+    ret = sr_replace_config(sess, NULL, dup, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* modify the data */
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces/interface[name='eth1']/description", "descr", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    /* replace it again, the modification must be reverted */
+    ret = sr_replace_config(sess, NULL, config, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 3);
+
+    /* check current data tree */
+    ret = sr_get_data(sess, "/ietf-interfaces:interfaces", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+    assert_int_equal(ret, 0);
+    sr_release_data(data);
+
+    str2 =
+            "<interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">"
+            "<interface>"
+            "<name>eth1</name>"
+            "<type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>"
+            "</interface>"
+            "</interfaces>";
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    sr_unsubscribe(subscr);
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static void
+test_sysrepocfg_stream(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    struct lyd_node *tree, *node;
+    sr_data_t *data;
+    FILE *file;
+    char *str1;
+    const char *str2;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* several top-level subtrees, "when2" data depend on the preceding "when1" data, which continue after them */
+    file = fopen(TESTS_REPO_DIR "/test_copy_config_stream.xml", "w");
+    assert_non_null(file);
+    fputs("<l1 xmlns=\"urn:when1\">val</l1>"
+            "<cont xmlns=\"urn:when2\"><l>val</l></cont>"
+            "<l2 xmlns=\"urn:when1\">val2</l2>", file);
+    assert_int_equal(fclose(file), 0);
+
+    /* streaming import, applied module by module */
+    ret = system(SR_BINARY_DIR "/sysrepocfg --import=" TESTS_REPO_DIR "/test_copy_config_stream.xml --stream");
+    assert_int_equal(ret, 0);
+
+    ret = sr_get_data(sess, "/when1:*|/when2:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+    assert_int_equal(ret, 0);
+    sr_release_data(data);
+
+    str2 =
+            "<l1 xmlns=\"urn:when1\">val</l1>"
+            "<l2 xmlns=\"urn:when1\">val2</l2>"
+            "<cont xmlns=\"urn:when2\"><l>val</l></cont>";
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    /* streaming export, must be a single valid JSON document with the data of all the modules */
+    ret = system(SR_BINARY_DIR "/sysrepocfg --export=" TESTS_REPO_DIR "/test_copy_config_stream.json --stream");
+    assert_int_equal(ret, 0);
+
+    ret = lyd_parse_data_path(st->ly_ctx, TESTS_REPO_DIR "/test_copy_config_stream.json", LYD_JSON,
+            LYD_PARSE_ONLY | LYD_PARSE_STRICT, 0, &tree);
+    assert_int_equal(ret, LY_SUCCESS);
+    assert_int_equal(lyd_find_path(tree, "/when1:l1", 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_find_path(tree, "/when1:l2", 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_find_path(tree, "/when2:cont/l", 0, &node), LY_SUCCESS);
+    lyd_free_siblings(tree);
+
+    unlink(TESTS_REPO_DIR "/test_copy_config_stream.xml");
+    unlink(TESTS_REPO_DIR "/test_copy_config_stream.json");
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/when2:cont", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/when1:l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/when1:l2", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static void
+test_sysrepocfg_backup(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_datastore_t ds;
+    sr_data_t *data;
+    char *str1;
+    const char *str2;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* data of 2 modules depending on each other in running and startup */
+    ret = sr_set_item_str(sess, "/when1:l1", "val", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/when2:cont/l", "val", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_switch_ds(sess, SR_DS_STARTUP);
+    ret = sr_copy_config(sess, NULL, SR_DS_RUNNING, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* backup */
+    ret = system(SR_BINARY_DIR "/sysrepocfg --backup=" TESTS_REPO_DIR "/test_copy_config_backup");
+    assert_int_equal(ret, 0);
+    assert_int_equal(access(TESTS_REPO_DIR "/test_copy_config_backup/manifest", F_OK), 0);
+
+    /* remove the data */
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
+        sr_session_switch_ds(sess, ds);
+        ret = sr_delete_item(sess, "/when2:cont", 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_delete_item(sess, "/when1:l1", 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    /* restore, "when2" data are valid only together with "when1" data */
+    ret = system(SR_BINARY_DIR "/sysrepocfg --restore=" TESTS_REPO_DIR "/test_copy_config_backup");
+    assert_int_equal(ret, 0);
+
+    str2 =
+            "<l1 xmlns=\"urn:when1\">val</l1>"
+            "<cont xmlns=\"urn:when2\"><l>val</l></cont>";
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
+        sr_session_switch_ds(sess, ds);
+        ret = sr_get_data(sess, "/when1:*|/when2:*", 0, 0, 0, &data);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+        assert_int_equal(ret, 0);
+        sr_release_data(data);
+
+        assert_string_equal(str1, str2);
+        free(str1);
+    }
+
+    /* failed backup into the same directory, the module data file cannot be written */
+    assert_int_equal(unlink(TESTS_REPO_DIR "/test_copy_config_backup/when1.running.lyb"), 0);
+    assert_int_equal(mkdir(TESTS_REPO_DIR "/test_copy_config_backup/when1.running.lyb", 00755), 0);
+    ret = system(SR_BINARY_DIR "/sysrepocfg --backup=" TESTS_REPO_DIR "/test_copy_config_backup");
+    assert_int_not_equal(ret, 0);
+
+    /* no stale manifest */
+    assert_int_not_equal(access(TESTS_REPO_DIR "/test_copy_config_backup/manifest", F_OK), 0);
+
+    /* cleanup */
+    ret = system("rm -rf " TESTS_REPO_DIR "/test_copy_config_backup");
+    assert_int_equal(ret, 0);
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
+        sr_session_switch_ds(sess, ds);
+        ret = sr_delete_item(sess, "/when2:cont", 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_delete_item(sess, "/when1:l1", 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    sr_session_stop(sess);
+}
+
 /* MAIN */
 int
 main(void)
@@ -2429,6 +2681,9 @@ main(void)
         cmocka_unit_test_setup_teardown(test_replace_dflt, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_case, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_when, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_replace_unchanged, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_sysrepocfg_stream, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_sysrepocfg_backup, setup_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
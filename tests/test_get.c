@@ -102,11 +102,18 @@ test_invalid(void **state)
 {
     struct state *st = (struct state *)*state;
     sr_data_t *data;
+    sr_val_t *val;
     int ret;
 
     /* invalid xpath */
     ret = sr_get_data(st->sess, "/simple:*/name()//.", 0, 0, 0, &data);
     assert_int_equal(ret, SR_ERR_LY);
+
+    /* invalid simple paths */
+    ret = sr_get_item(st->sess, "/simple:ac1/acl1[acs1='a']/nonexistent", 0, &val);
+    assert_int_equal(ret, SR_ERR_LY);
+    ret = sr_get_node(st->sess, "/simple:ac1/nonexistent", 0, &data);
+    assert_int_equal(ret, SR_ERR_LY);
 }
 
 /* TEST */
@@ -1380,7 +1380,7 @@ test_params(void **state)
     struct state *st = (struct state *)*state;
     sr_subscription_ctx_t *subscr = NULL;
     int ret;
-    uint32_t sub_id, filtered_out;
+    uint32_t sub_id, sub_id2, filtered_out;
     struct lyd_node *notif;
     const char *module_name, *xpath;
     struct timespec cur, start, stop;
@@ -1393,6 +1393,10 @@ test_params(void **state)
             SR_SUBSCR_NO_THREAD, &subscr);
     assert_int_equal(ret, SR_ERR_OK);
     sub_id = sr_subscription_get_last_sub_id(subscr);
+    ret = sr_notif_subscribe(st->sess, "ops", "/ops:notif3/list2[k='1']", NULL, NULL, notif_params_cb, st,
+            SR_SUBSCR_NO_THREAD, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    sub_id2 = sr_subscription_get_last_sub_id(subscr);
 
     /* send filtered-out notif */
     assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:notif4/l", "neither", 0, &notif));
@@ -1413,6 +1417,12 @@ test_params(void **state)
     assert_int_equal(stop.tv_sec, 0);
     assert_int_equal(filtered_out, 1);
 
+    /* filtered out for a different notification */
+    ret = sr_notif_sub_get_info(subscr, sub_id2, &module_name, &xpath, &start, &stop, &filtered_out);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(xpath, "/ops:notif3/list2[k='1']");
+    assert_int_equal(filtered_out, 1);
+
     /* change filter, callback called */
     ret = sr_notif_sub_modify_xpath(subscr, sub_id, "/ops:notif4[l='wrong']");
     assert_int_equal(ret, SR_ERR_OK);
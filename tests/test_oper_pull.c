@@ -249,7 +249,7 @@ static void
 test_yang_lib(void **state)
 {
     struct state *st = (struct state *)*state;
-    sr_data_t *data;
+    sr_data_t *data, *data2;
     sr_subscription_ctx_t *subscr = NULL;
     int ret;
 
@@ -276,6 +276,12 @@ test_yang_lib(void **state)
     assert_string_equal(data->tree->schema->name, "modules-state");
     assert_string_equal(lyd_child(data->tree)->prev->schema->name, "module-set-id");
 #endif
+
+    /* read them again, cached */
+    ret = sr_get_data(st->sess, "/ietf-yang-library:*", 0, 0, 0, &data2);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(lyd_compare_siblings(data->tree, data2->tree, LYD_COMPARE_FULL_RECURSION), LY_SUCCESS);
+    sr_release_data(data2);
     sr_release_data(data);
 
     /* subscribe as dummy state data provider, they should get deleted */
@@ -949,6 +955,40 @@ test_sr_mon(void **state)
     assert_string_equal(str1, str2);
     free(str1);
 
+    /* get only the subscriptions of a single module */
+    ret = sr_get_data(st->sess, "/sysrepo-monitoring:sysrepo-state/module[name='ietf-interfaces']/subscriptions", 0, 0,
+            0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, 0);
+    assert_int_equal(ret, 0);
+    sr_release_data(data);
+
+    strcpy(str2, "<sysrepo-state xmlns=\"http://www.sysrepo.org/yang/sysrepo-monitoring\">\n"
+            "  <module>\n"
+            "    <name>ietf-interfaces</name>\n"
+            "    <subscriptions>\n"
+            "      <change-sub>\n"
+            "        <datastore xmlns:ds=\"urn:ietf:params:xml:ns:yang:ietf-datastores\">ds:operational</datastore>\n"
+            "        <xpath xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces</xpath>\n"
+            "        <priority>3</priority>\n"
+            "        <cid></cid>\n"
+            "        <suspended>false</suspended>\n"
+            "      </change-sub>\n"
+            "      <operational-get-sub>\n"
+            "        <xpath xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces-state</xpath>\n"
+            "        <xpath-sub>\n"
+            "          <cid></cid>\n"
+            "          <suspended>false</suspended>\n"
+            "        </xpath-sub>\n"
+            "      </operational-get-sub>\n"
+            "    </subscriptions>\n"
+            "  </module>\n"
+            "</sysrepo-state>\n");
+    sr_str_del(str1, "<cid>", "</cid>");
+    assert_string_equal(str1, str2);
+    free(str1);
+
     sr_session_switch_ds(st->sess, SR_DS_RUNNING);
 
     sr_unsubscribe(subscr);
@@ -957,6 +997,75 @@ test_sr_mon(void **state)
     free(str2);
 }
 
+/* TEST */
+static int
+srmon_enabled_change_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    sr_session_ctx_t *sess;
+    sr_data_t *data;
+    char *str;
+    int ret;
+
+    (void)sub_id;
+    (void)module_name;
+    (void)xpath;
+    (void)request_id;
+
+    assert_int_equal(event, SR_EV_ENABLED);
+
+    /* the change subscription lock of the module is held, it must not be needed */
+    ret = sr_session_start(sr_session_get_connection(session), SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/sysrepo-monitoring:sysrepo-state/module[name='test']/subscriptions", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str, data->tree, LYD_XML, 0);
+    assert_int_equal(ret, 0);
+    sr_release_data(data);
+    sr_session_stop(sess);
+
+    assert_string_equal(str, "<sysrepo-state xmlns=\"http://www.sysrepo.org/yang/sysrepo-monitoring\">\n"
+            "  <module>\n"
+            "    <name>test</name>\n"
+            "  </module>\n"
+            "</sysrepo-state>\n");
+    free(str);
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_sr_mon_no_subs(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_data_t *data;
+    struct lyd_node *node;
+    int ret;
+
+    /* read the subscriptions while subscribing to the module without any subscriptions */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_module_change_subscribe(st->sess, "test", NULL, srmon_enabled_change_cb, st, 0, SR_SUBSCR_ENABLED,
+            &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* the subscription is there now */
+    sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    ret = sr_get_data(st->sess, "/sysrepo-monitoring:sysrepo-state/module[name='test']/subscriptions", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = lyd_find_path(data->tree, "module[name='test']/subscriptions/change-sub/priority", 0, &node);
+    assert_int_equal(ret, LY_SUCCESS);
+    assert_string_equal(lyd_get_value(node), "0");
+    sr_release_data(data);
+    sr_session_switch_ds(st->sess, SR_DS_RUNNING);
+
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static int
 enabled_change_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath, sr_event_t event,
@@ -3882,6 +3991,7 @@ main(void)
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_yang_lib),
         cmocka_unit_test(test_sr_mon),
+        cmocka_unit_test(test_sr_mon_no_subs),
         cmocka_unit_test_teardown(test_enabled_partial, clear_up),
         cmocka_unit_test_teardown(test_simple, clear_up),
         cmocka_unit_test_teardown(test_fail, clear_up),
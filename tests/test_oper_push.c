@@ -2356,12 +2356,31 @@ test_np_cont2(void **state)
 }
 
 /* TEST */
+static int
+dummy_oper_get_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        const char *request_xpath, uint32_t request_id, struct lyd_node **parent, void *private_data)
+{
+    (void)session;
+    (void)sub_id;
+    (void)module_name;
+    (void)xpath;
+    (void)request_xpath;
+    (void)request_id;
+    (void)parent;
+    (void)private_data;
+
+    return SR_ERR_OK;
+}
+
 static void
 test_schema_mount(void **state)
 {
     struct state *st = (struct state *)*state;
     sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *subscr = NULL;
     sr_data_t *data;
+    const struct lyd_node *ext_data;
+    uint32_t sm_ver;
     char *str1;
     const char *str2;
     int ret;
@@ -2411,6 +2430,61 @@ test_schema_mount(void **state)
             "</root>\n";
     assert_string_equal(str1, str2);
     free(str1);
+
+    /* new session reusing the unchanged LY ext data */
+    sm_ver = ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver);
+    ext_data = st->conn->ly_ext_data;
+    ret = sr_session_start(st->conn, SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_ptr_equal(st->conn->ly_ext_data, ext_data);
+    assert_true(st->conn->ly_ext_data_valid);
+    assert_int_equal(st->conn->ly_ext_data_sm_ver, sm_ver);
+    assert_int_equal(st->conn->ly_ext_data_content_id, SR_CONN_MAIN_SHM(st->conn)->content_id);
+    ret = sr_set_item_str(sess, "/sm:root/ietf-interfaces:interfaces/interface[name='eth1']/enabled", "false",
+            NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_discard_changes(sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+
+    /* update the oper ext data, LY ext data are rebuilt */
+    ret = sr_set_item_str(st->sess,
+            "/ietf-yang-schema-mount:schema-mounts/mount-point[module='sm'][label='root']/config", "true", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_not_equal(ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver), sm_ver);
+    sm_ver = ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver);
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+    assert_true(st->conn->ly_ext_data_valid);
+    assert_int_equal(st->conn->ly_ext_data_sm_ver, sm_ver);
+
+    /* oper get subscription providing the oper ext data, LY ext data are rebuilt and not reused */
+    ret = sr_oper_get_subscribe(st->sess, "ietf-yang-schema-mount", "/ietf-yang-schema-mount:schema-mounts",
+            dummy_oper_get_cb, NULL, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_not_equal(ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver), sm_ver);
+    sm_ver = ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver);
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+    assert_false(st->conn->ly_ext_data_valid);
+    assert_int_equal(st->conn->ly_ext_data_sm_ver, sm_ver);
+
+    /* no subscription, LY ext data are rebuilt and reusable again */
+    sr_unsubscribe(subscr);
+    assert_int_not_equal(ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver), sm_ver);
+    sm_ver = ATOMIC_LOAD_RELAXED(SR_CONN_MAIN_SHM(st->conn)->sm_data_ver);
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+    assert_true(st->conn->ly_ext_data_valid);
+    assert_int_equal(st->conn->ly_ext_data_sm_ver, sm_ver);
 }
 
 /* TEST */
@@ -16,6 +16,7 @@
 
 #define _GNU_SOURCE
 
+#include <dirent.h>
 #include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -1741,6 +1742,119 @@ test_recover_notif_sub(int rp, int wp)
     return 0;
 }
 
+/* TEST */
+static int
+count_fds(void)
+{
+    DIR *dir;
+    struct dirent *ent;
+    int count = 0;
+
+    dir = opendir("/proc/self/fd");
+    if (!dir) {
+        return -1;
+    }
+    while ((ent = readdir(dir))) {
+        if (ent->d_name[0] != '.') {
+            ++count;
+        }
+    }
+    closedir(dir);
+
+    return count;
+}
+
+static int
+test_conn_alive_check(int rp, int wp)
+{
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    sr_data_t *data;
+    struct lyd_node *node;
+    struct ly_set *set;
+    int ret, fd_count;
+
+    /* wait for the subscription */
+    barrier(rp, wp);
+
+    /* first connection of this process, without checking any other connections */
+    ret = sr_connect(0, &conn);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_OPERATIONAL, &sess);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/sysrepo-monitoring:sysrepo-state/module[name='ietf-interfaces']/subscriptions", 0, 0, 0,
+            &data);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(data);
+    sr_disconnect(conn);
+
+    fd_count = count_fds();
+    sr_assert_true(fd_count > -1);
+
+    /* the connection of the other process is checked and found alive */
+    ret = sr_connect(0, &conn);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_OPERATIONAL, &sess);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/sysrepo-monitoring:sysrepo-state/module[name='test']/subscriptions", 0, 0, 0, &data);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = lyd_find_path(data->tree, "module[name='test']/subscriptions/change-sub", 0, &node);
+    sr_assert_int_equal(ret, LY_SUCCESS);
+    sr_release_data(data);
+
+    /* the other process disconnects cleanly but keeps running */
+    barrier(rp, wp);
+    barrier(rp, wp);
+
+    /* its connection is not alive */
+    ret = sr_get_data(sess, "/sysrepo-monitoring:sysrepo-state/connection", 0, 0, 0, &data);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = lyd_find_xpath(data->tree, "connection", &set);
+    sr_assert_int_equal(ret, LY_SUCCESS);
+    sr_assert_int_equal(set->count, 1);
+    ly_set_free(set, NULL);
+    sr_release_data(data);
+
+    /* no file descriptors are kept for the other process after the last connection is closed */
+    sr_disconnect(conn);
+    sr_assert_int_equal(count_fds(), fd_count);
+
+    barrier(rp, wp);
+    return 0;
+}
+
+static int
+test_conn_alive_sub(int rp, int wp)
+{
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *sub = NULL;
+    int ret;
+
+    ret = sr_connect(0, &conn);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_RUNNING, &sess);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "test", NULL, module_change_dummy_cb, NULL, 0, 0, &sub);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+
+    /* subscribed */
+    barrier(rp, wp);
+
+    /* the other process checked this connection */
+    barrier(rp, wp);
+
+    sr_unsubscribe(sub);
+    ret = sr_disconnect(conn);
+    sr_assert_int_equal(ret, SR_ERR_OK);
+
+    /* disconnected, keep running until the other process finishes */
+    barrier(rp, wp);
+    barrier(rp, wp);
+    return 0;
+}
+
 int
 main(void)
 {
@@ -1758,6 +1872,7 @@ main(void)
         {"recover-oper-sub", test_recover_oper_sub_get, test_recover_oper_sub, setup, teardown},
         {"recover-rpc-sub", test_recover_rpc_sub_send, test_recover_rpc_sub, setup, teardown},
         {"recover-notif-sub", test_recover_notif_sub_send, test_recover_notif_sub, setup, teardown},
+        {"conn alive", test_conn_alive_check, test_conn_alive_sub, setup, teardown},
     };
 
     test_log_init();
@@ -1986,8 +1986,40 @@ test_factory_reset(void **state)
     assert_string_equal(str, xml);
     free(str);
 
-    /* cleanup */
     sr_unsubscribe(subscr);
+
+    /* modify startup and running DS */
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ++ds) {
+        sr_session_switch_ds(st->sess, ds);
+
+        ret = sr_delete_item(st->sess, "/test:test-leaf", 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_set_item_str(st->sess, "/test:cont/l2[k='key']/v", "6", NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(st->sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    /* execute without any change subscriptions */
+    ret = lyd_new_path(NULL, st->ly_ctx, "/ietf-factory-default:factory-reset", NULL, 0, &input);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_rpc_send_tree(st->sess, input, 0, &output);
+    lyd_free_tree(input);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(output);
+
+    /* check DS contents */
+    for (ds = SR_DS_STARTUP; ds <= SR_DS_CANDIDATE; ++ds) {
+        sr_session_switch_ds(st->sess, ds);
+        ret = sr_get_data(st->sess, "/*", 0, 0, 0, &data);
+        assert_int_equal(ret, SR_ERR_OK);
+        assert_non_null(data);
+        ret = lyd_print_mem(&str, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+        sr_release_data(data);
+        assert_int_equal(ret, LY_SUCCESS);
+        assert_string_equal(str, xml);
+        free(str);
+    }
 }
 
 /* MAIN */